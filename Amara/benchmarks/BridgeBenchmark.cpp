@@ -0,0 +1,157 @@
+// Per call overhead of the engine's bridge entry points. Each JS batch makes `range(0)` calls to one host function
+// from a loop, so items_per_second is calls per second; BM_EmptyLoop is the loop on its own. The C++ -> JS cases
+// call a JS function straight through JSI the way the engine calls components, effects and list items.
+// Batches run inside a fresh ComponentContext that is torn down untimed, hooks and widgets don't pile up.
+
+#include <benchmark/benchmark.h>
+
+#include "../runtime/hermes/InstallEngine.h"
+#include "../utils/BridgeStats.h"
+
+static const char *kBridgeBatches = R"(
+globalThis.bridgeBench = {
+    emptyLoop: n => {
+        for (let i = 0; i < n; i++) {
+        }
+    },
+    toRaw: n => {
+        for (let i = 0; i < n; i++) toRaw(i);
+    },
+    createElement: n => {
+        for (let i = 0; i < n; i++) createElement("div", {});
+    },
+    addText: n => {
+        const text = createElement("text", {});
+        for (let i = 0; i < n; i++) text.addText("row");
+    },
+    insertChild: n => {
+        const text = createElement("text", {});
+        for (let i = 0; i < n; i++) text.insertChild(1, "row");
+    },
+    useState: n => {
+        for (let i = 0; i < n; i++) useState(i);
+    },
+    setState: n => {
+        const [value, setValue] = useState(-1);
+        for (let i = 0; i < n; i++) setValue(i);
+    },
+    effect: n => {
+        for (let i = 0; i < n; i++) effect(() => {}, []);
+    },
+    cellGet: n => {
+        const [label] = useState("row");
+        for (let i = 0; i < n; i++) label.length;
+    },
+    listConciliar: n => {
+        const list = createElement("component", {});
+        const items = ["row"];
+        const row = item => ({
+            "$$internalComponent": true,
+            "component": "text",
+            "key": item,
+            "props": {"children": [item]},
+            "id": "bridgeRow"
+        });
+        for (let i = 0; i < n; i++) listConciliar(list, items, row);
+    }
+};
+globalThis.noop = function () {
+};
+globalThis.readProps = function (props) {
+    return props.label;
+};
+)";
+
+struct BridgeFixture {
+    std::unique_ptr<HermesEngine> engine = installEngine();
+    Object batches = load(*engine);
+
+    static Object load(HermesEngine &engine) {
+        auto &rt = engine.getRuntime();
+        rt.evaluateJavaScript(std::make_shared<StringBuffer>(kBridgeBatches), "bridge.js");
+        return rt.global().getPropertyAsObject(rt, "bridgeBench");
+    }
+
+    static BridgeFixture &get() {
+        static BridgeFixture fixture;
+        return fixture;
+    }
+};
+
+// Times `batch` with `range(0)` calls per iteration, each batch in its own component.
+static void runBatch(benchmark::State &state, const char *batch) {
+    auto &fixture = BridgeFixture::get();
+    auto &engine = *fixture.engine;
+    auto &rt = engine.getRuntime();
+    const auto calls = state.range(0);
+    const auto function = fixture.batches.getPropertyAsFunction(rt, batch);
+    for (auto _: state) {
+        state.PauseTiming();
+        auto context = std::make_shared<ComponentContext>(&engine);
+        engine.plugComponent(context);
+        state.ResumeTiming();
+
+        function.call(rt, static_cast<double>(calls));
+
+        state.PauseTiming();
+        engine.unplugComponent();
+        engine.updates().clear();
+        // The component isn't mounted anywhere, unmounting hands it to the ReclaimQueue with the widgets it created.
+        engine.unmountComponent(*context);
+        engine.reclaimer().drainAll();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * calls);
+}
+
+#define BRIDGE_BATCH_BENCHMARK(name, batch) \
+    static void name(benchmark::State &state) { runBatch(state, batch); } \
+    BENCHMARK(name)->Arg(1000);
+
+BRIDGE_BATCH_BENCHMARK(BM_EmptyLoop, "emptyLoop")
+BRIDGE_BATCH_BENCHMARK(BM_ToRaw, "toRaw")
+BRIDGE_BATCH_BENCHMARK(BM_CreateElement, "createElement")
+BRIDGE_BATCH_BENCHMARK(BM_AddText, "addText")
+BRIDGE_BATCH_BENCHMARK(BM_InsertChild, "insertChild")
+BRIDGE_BATCH_BENCHMARK(BM_UseState, "useState")
+BRIDGE_BATCH_BENCHMARK(BM_SetState, "setState")
+BRIDGE_BATCH_BENCHMARK(BM_Effect, "effect")
+BRIDGE_BATCH_BENCHMARK(BM_StateCellGet, "cellGet")
+BRIDGE_BATCH_BENCHMARK(BM_ListConciliar, "listConciliar")
+
+// The same toRaw batch with BridgeStats switched on, the difference to BM_ToRaw is the instrumentation cost.
+static void BM_ToRawCounted(benchmark::State &state) {
+    BridgeStats::setEnabled(true);
+    runBatch(state, "toRaw");
+    BridgeStats::setEnabled(false);
+    BridgeStats::reset();
+}
+
+BENCHMARK(BM_ToRawCounted)->Arg(1000);
+
+static void BM_CallJsFunction(benchmark::State &state) {
+    auto &rt = BridgeFixture::get().engine->getRuntime();
+    const auto noop = rt.global().getPropertyAsFunction(rt, "noop");
+    for (auto _: state) {
+        auto result = noop.call(rt);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CallJsFunction);
+
+// Like a component or list item call: one object argument, one property read on the JS side.
+static void BM_CallJsWithProps(benchmark::State &state) {
+    auto &rt = BridgeFixture::get().engine->getRuntime();
+    const auto readProps = rt.global().getPropertyAsFunction(rt, "readProps");
+    Object props(rt);
+    props.setProperty(rt, "label", "row");
+    for (auto _: state) {
+        auto result = readProps.call(rt, props);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CallJsWithProps);
@@ -0,0 +1,106 @@
+// Microbenchmarks for the style parser: single values, shorthands, colors, borders and whole declarations.
+
+#include <benchmark/benchmark.h>
+
+#include "../utils/css/CssUtils.h"
+
+static void BM_ParseCSSValue(benchmark::State &state, const char *input) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseCSSValue(input));
+    }
+}
+
+BENCHMARK_CAPTURE(BM_ParseCSSValue, px, "120px");
+BENCHMARK_CAPTURE(BM_ParseCSSValue, percent, "33.5%");
+BENCHMARK_CAPTURE(BM_ParseCSSValue, unitless, "16");
+BENCHMARK_CAPTURE(BM_ParseCSSValue, auto, "auto");
+BENCHMARK_CAPTURE(BM_ParseCSSValue, invalid, "12em");
+
+static void BM_ParseMarginOrPadding(benchmark::State &state, const char *input) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseMarginOrPadding(input));
+    }
+}
+
+BENCHMARK_CAPTURE(BM_ParseMarginOrPadding, one, "8px");
+BENCHMARK_CAPTURE(BM_ParseMarginOrPadding, four, "4px 8px 12px 16px");
+
+static void BM_ParseFlexShorthand(benchmark::State &state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseFlexShorthand("1 0 120px"));
+    }
+}
+
+BENCHMARK(BM_ParseFlexShorthand);
+
+static void BM_ParseColor(benchmark::State &state, const char *input) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(Color::isValid(input) ? Color(input) : Color());
+    }
+}
+
+BENCHMARK_CAPTURE(BM_ParseColor, short, "#f0a");
+BENCHMARK_CAPTURE(BM_ParseColor, full, "#12ab34ff");
+BENCHMARK_CAPTURE(BM_ParseColor, invalid, "red");
+
+static void BM_ParseBorderColor(benchmark::State &state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseBorderColor("#000 #fff #123456 #abcdef"));
+    }
+}
+
+BENCHMARK(BM_ParseBorderColor);
+
+static void BM_ParseBorderShorthand(benchmark::State &state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseBorderShorthand("1px solid #ff0000"));
+    }
+}
+
+BENCHMARK(BM_ParseBorderShorthand);
+
+static void BM_ParseBorderRadius(benchmark::State &state) {
+    for (auto _: state) {
+        benchmark::DoNotOptimize(parseBorderRadius("4px 8px 4px 8px"));
+    }
+}
+
+BENCHMARK(BM_ParseBorderRadius);
+
+static void BM_LookupStyleProperty(benchmark::State &state, const char *name) {
+    StyleProperty property;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(lookupStyleProperty(name, property));
+    }
+}
+
+BENCHMARK_CAPTURE(BM_LookupStyleProperty, kebab, "border-top-left-radius");
+BENCHMARK_CAPTURE(BM_LookupStyleProperty, camel, "justifyContent");
+BENCHMARK_CAPTURE(BM_LookupStyleProperty, unknown, "backgroundImage");
+
+// A typical widget style, applied the way Widget::parseStyle does it.
+static void BM_ApplyStyle(benchmark::State &state) {
+    static const std::pair<const char *, const char *> declarations[] = {
+        {"display", "flex"},
+        {"flexDirection", "row"},
+        {"justify-content", "space-between"},
+        {"alignItems", "center"},
+        {"width", "100%"},
+        {"height", "48px"},
+        {"padding", "8px 16px"},
+        {"margin", "0 auto"},
+        {"border", "1px solid #cccccc"},
+        {"borderRadius", "6px"},
+        {"gap", "8px"},
+        {"flex", "1 1 0"},
+    };
+    for (auto _: state) {
+        WidgetStyle style;
+        for (const auto &[key, value]: declarations) {
+            applyStyleProperty(style, key, value);
+        }
+        benchmark::DoNotOptimize(style);
+    }
+}
+
+BENCHMARK(BM_ApplyStyle);
@@ -0,0 +1,195 @@
+// js-framework-benchmark style operations on the whole engine: the rows.js bundle runs on installEngine(), every
+// operation is a setState through benchmarkActions followed by ticks until the scheduler is idle, so the time
+// includes JS, listConciliar, the reconciler and layout.
+// Counters are per operation: `updates` (component update() calls), `widgets_allocated` and `pool_hits` (WidgetPool
+// misses and hits) plus the process' `peak_rss_kb` so far.
+// Run with --benchmark_format=json (or --benchmark_out=<file>) for machine readable results.
+
+#include <stdexcept>
+
+#include <benchmark/benchmark.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../runtime/hermes/BundleLoader.h"
+#include "../runtime/hermes/InstallEngine.h"
+
+static double peakRssKb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return static_cast<double>(counters.PeakWorkingSetSize) / 1024.0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    // Bytes on macOS, kilobytes everywhere else.
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+    return static_cast<double>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// One engine for the whole suite, booting hermes per benchmark would dwarf the smaller operations.
+struct EndToEndFixture {
+    std::unique_ptr<HermesEngine> engine = installEngine();
+    Object actions = load(*engine);
+
+    static Object load(HermesEngine &engine) {
+        const auto bundle = BundleLoader().load(AMARA_BENCHMARK_JS_DIR "/rows.js");
+        if (!bundle) {
+            throw std::runtime_error("Couldn't load rows.js");
+        }
+        engine.execute(*bundle);
+        auto &rt = engine.getRuntime();
+        return rt.global().getPropertyAsObject(rt, "benchmarkActions");
+    }
+
+    static EndToEndFixture &get() {
+        static EndToEndFixture fixture;
+        return fixture;
+    }
+
+    template<typename... Args>
+    void run(const char *action, Args... args) {
+        auto &rt = engine->getRuntime();
+        actions.getPropertyAsFunction(rt, action).call(rt, Value(static_cast<double>(args))...);
+    }
+
+    // Ticks until every scheduled update ran, returns the update() calls made.
+    size_t flush() {
+        size_t updated = 0;
+        while (engine->hasPendingWork()) {
+            updated += engine->tick().updated;
+        }
+        return updated;
+    }
+};
+
+// Sums the counters over the timed part of each iteration.
+struct OperationCounters {
+    size_t updates = 0;
+    size_t allocated = 0;
+    size_t reused = 0;
+    WidgetPoolStats start;
+
+    void begin(const HermesEngine &engine) {
+        start = engine.poolStats();
+    }
+
+    void end(const HermesEngine &engine, size_t updated) {
+        const auto &stats = engine.poolStats();
+        updates += updated;
+        allocated += stats.allocated - start.allocated;
+        reused += stats.reused - start.reused;
+    }
+
+    void report(benchmark::State &state) const {
+        const auto perIteration = benchmark::Counter::kAvgIterations;
+        state.counters["updates"] = benchmark::Counter(static_cast<double>(updates), perIteration);
+        state.counters["widgets_allocated"] = benchmark::Counter(static_cast<double>(allocated), perIteration);
+        state.counters["pool_hits"] = benchmark::Counter(static_cast<double>(reused), perIteration);
+        state.counters["peak_rss_kb"] = benchmark::Counter(peakRssKb());
+    }
+};
+
+// Untimed: replaces the table with `rows` fresh rows.
+static void prepare(EndToEndFixture &fixture, size_t rows) {
+    fixture.run("clear");
+    fixture.flush();
+    if (rows == 0) return;
+    fixture.run("create", rows);
+    fixture.flush();
+}
+
+// Times `action` on a table prepared with `rows` rows.
+template<typename Action>
+static void measure(benchmark::State &state, size_t rows, Action action) {
+    auto &fixture = EndToEndFixture::get();
+    OperationCounters counters;
+    for (auto _: state) {
+        state.PauseTiming();
+        prepare(fixture, rows);
+        counters.begin(*fixture.engine);
+        state.ResumeTiming();
+
+        action(fixture);
+        const auto updated = fixture.flush();
+
+        state.PauseTiming();
+        counters.end(*fixture.engine, updated);
+        state.ResumeTiming();
+    }
+    counters.report(state);
+}
+
+static void BM_CreateRows(benchmark::State &state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    measure(state, 0, [rows](EndToEndFixture &fixture) {
+        fixture.run("create", rows);
+    });
+}
+
+BENCHMARK(BM_CreateRows)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_ReplaceAllRows(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("create", 1000);
+    });
+}
+
+BENCHMARK(BM_ReplaceAllRows)->Unit(benchmark::kMillisecond);
+
+static void BM_UpdateEvery10thRow(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("updateEvery", 10);
+    });
+}
+
+BENCHMARK(BM_UpdateEvery10thRow)->Unit(benchmark::kMillisecond);
+
+static void BM_SelectRow(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("select", 1);
+    });
+}
+
+BENCHMARK(BM_SelectRow)->Unit(benchmark::kMillisecond);
+
+static void BM_SwapRows(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("swap", 1, 998);
+    });
+}
+
+BENCHMARK(BM_SwapRows)->Unit(benchmark::kMillisecond);
+
+static void BM_RemoveRow(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("remove", 1);
+    });
+}
+
+BENCHMARK(BM_RemoveRow)->Unit(benchmark::kMillisecond);
+
+static void BM_AppendRows(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("append", 1000);
+    });
+}
+
+BENCHMARK(BM_AppendRows)->Unit(benchmark::kMillisecond);
+
+static void BM_ClearRows(benchmark::State &state) {
+    measure(state, 1000, [](EndToEndFixture &fixture) {
+        fixture.run("clear");
+    });
+}
+
+BENCHMARK(BM_ClearRows)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,99 @@
+// Compares the native HermesPropDiffer against the diffAndUpdate JS helper it replaced.
+// Both diff the same pair of freshly created prop objects, since diffing writes the changes into the old one.
+
+#include <fstream>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include "../runtime/hermes/PropDiffer.h"
+
+using namespace facebook::jsi;
+
+static const char *kPropsFactory = R"(
+function makeProps(variant) {
+    return {
+        key: "row",
+        className: variant ? "active" : "idle",
+        onClick: function () {},
+        title: "Item " + variant,
+        style: {
+            display: "flex",
+            width: variant ? "120px" : "100px",
+            height: "40px",
+            margin: "4px 8px",
+            "flex-direction": "row",
+            "justify-content": "center",
+        },
+        data: [1, 2, variant],
+        children: [],
+    };
+}
+)";
+
+static std::string readFile(const std::string &path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static Runtime &loadScripts(Runtime &rt) {
+    rt.evaluateJavaScript(std::make_shared<StringBuffer>(kPropsFactory), "props.js");
+    rt.evaluateJavaScript(std::make_shared<StringBuffer>(readFile(AMARA_BENCHMARK_JS_DIR "/diffAndUpdate.js")),
+                          "diffAndUpdate.js");
+    return rt;
+}
+
+// One runtime for the whole suite, with the factory and the old JS differ loaded.
+struct PropDiffFixture {
+    std::unique_ptr<facebook::hermes::HermesRuntime> runtime = facebook::hermes::makeHermesRuntime();
+    Function makeProps = loadScripts(*runtime).global().getPropertyAsFunction(*runtime, "makeProps");
+    Function diffAndUpdate = runtime->global().getPropertyAsFunction(*runtime, "diffAndUpdate");
+
+    static PropDiffFixture &get() {
+        static PropDiffFixture fixture;
+        return fixture;
+    }
+};
+
+// Baseline: what creating the two prop objects costs on its own.
+static void BM_CreateProps(benchmark::State &state) {
+    auto &fixture = PropDiffFixture::get();
+    auto &rt = *fixture.runtime;
+    for (auto _: state) {
+        auto oldProps = fixture.makeProps.call(rt, 0);
+        auto newProps = fixture.makeProps.call(rt, 1);
+        benchmark::DoNotOptimize(newProps);
+    }
+}
+
+BENCHMARK(BM_CreateProps);
+
+static void BM_DiffAndUpdateJS(benchmark::State &state) {
+    auto &fixture = PropDiffFixture::get();
+    auto &rt = *fixture.runtime;
+    for (auto _: state) {
+        auto oldProps = fixture.makeProps.call(rt, 0);
+        auto newProps = fixture.makeProps.call(rt, 1);
+        benchmark::DoNotOptimize(fixture.diffAndUpdate.call(rt, oldProps, newProps));
+    }
+}
+
+BENCHMARK(BM_DiffAndUpdateJS);
+
+static void BM_HermesPropDiffer(benchmark::State &state) {
+    auto &fixture = PropDiffFixture::get();
+    auto &rt = *fixture.runtime;
+    PropNameCache names(rt);
+    HermesPropDiffer differ(rt, names);
+    for (auto _: state) {
+        auto oldProps = fixture.makeProps.call(rt, 0).getObject(rt);
+        auto newProps = fixture.makeProps.call(rt, 1).getObject(rt);
+        benchmark::DoNotOptimize(differ.diff(oldProps, newProps));
+    }
+}
+
+BENCHMARK(BM_HermesPropDiffer);
@@ -0,0 +1,140 @@
+// Heap allocations made while wrapping JS values.
+// The "Boxed" cases reproduce the old unique_ptr per value, the others go through the engine's current API.
+// `allocs_per_value` counts every operator new in the loop, hermes' own handle allocations included.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include <benchmark/benchmark.h>
+#include <hermes/hermes.h>
+#include <jsi/jsi.h>
+
+#include "../runtime/hermes/HermesArray.h"
+#include "../runtime/hermes/StateWrapper.h"
+
+using namespace facebook::jsi;
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+static const char *kListFactory = R"(
+function makeList(size) {
+    const list = [];
+    for (let i = 0; i < size; i++) list.push("row-" + i);
+    return list;
+}
+function renderRow(item, index) {
+    return item;
+}
+)";
+
+struct StateWrapperFixture {
+    std::unique_ptr<facebook::hermes::HermesRuntime> runtime = facebook::hermes::makeHermesRuntime();
+    Function makeList = load(*runtime).global().getPropertyAsFunction(*runtime, "makeList");
+    Function renderRow = runtime->global().getPropertyAsFunction(*runtime, "renderRow");
+
+    static Runtime &load(Runtime &rt) {
+        rt.evaluateJavaScript(std::make_shared<StringBuffer>(kListFactory), "list.js");
+        return rt;
+    }
+
+    static StateWrapperFixture &get() {
+        static StateWrapperFixture fixture;
+        return fixture;
+    }
+};
+
+static void reportAllocations(benchmark::State &state, size_t before, size_t valuesPerIteration) {
+    const auto total = allocations.load(std::memory_order_relaxed) - before;
+    state.counters["allocs_per_value"] = benchmark::Counter(
+        static_cast<double>(total) / static_cast<double>(state.iterations() * valuesPerIteration));
+}
+
+// HermesArray::getValue for every element, like reconcileList and getChildren do.
+static void BM_WrapElementsBoxed(benchmark::State &state) {
+    auto &fixture = StateWrapperFixture::get();
+    auto &rt = *fixture.runtime;
+    const auto size = static_cast<size_t>(state.range(0));
+    auto list = fixture.makeList.call(rt, static_cast<double>(size)).getObject(rt).getArray(rt);
+    const size_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _: state) {
+        for (size_t i = 0; i < size; ++i) {
+            auto wrapper = std::make_unique<StateWrapper>(rt, list.getValueAtIndex(rt, i));
+            benchmark::DoNotOptimize(wrapper);
+        }
+    }
+    reportAllocations(state, before, size);
+}
+
+BENCHMARK(BM_WrapElementsBoxed)->Arg(1000);
+
+static void BM_WrapElements(benchmark::State &state) {
+    auto &fixture = StateWrapperFixture::get();
+    auto &rt = *fixture.runtime;
+    const auto size = static_cast<size_t>(state.range(0));
+    HermesArray list(rt, fixture.makeList.call(rt, static_cast<double>(size)));
+    const size_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _: state) {
+        for (size_t i = 0; i < size; ++i) {
+            auto wrapper = list.getValue(i);
+            benchmark::DoNotOptimize(wrapper);
+        }
+    }
+    reportAllocations(state, before, size);
+}
+
+BENCHMARK(BM_WrapElements)->Arg(1000);
+
+// The reconcileList loop: wrap the element, call the row function with it, wrap the result.
+static void BM_MapListBoxed(benchmark::State &state) {
+    auto &fixture = StateWrapperFixture::get();
+    auto &rt = *fixture.runtime;
+    const auto size = static_cast<size_t>(state.range(0));
+    auto list = fixture.makeList.call(rt, static_cast<double>(size)).getObject(rt).getArray(rt);
+    const size_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _: state) {
+        for (size_t i = 0; i < size; ++i) {
+            auto value = std::make_unique<StateWrapper>(rt, list.getValueAtIndex(rt, i));
+            auto result = std::make_unique<StateWrapper>(
+                rt, fixture.renderRow.call(rt, value->getValue(), Value(static_cast<double>(i))));
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    reportAllocations(state, before, size);
+}
+
+BENCHMARK(BM_MapListBoxed)->Arg(1000);
+
+static void BM_MapList(benchmark::State &state) {
+    auto &fixture = StateWrapperFixture::get();
+    auto &rt = *fixture.runtime;
+    const auto size = static_cast<size_t>(state.range(0));
+    HermesArray list(rt, fixture.makeList.call(rt, static_cast<double>(size)));
+    auto func = StateWrapper::create(rt, Value(rt, fixture.renderRow));
+    const size_t before = allocations.load(std::memory_order_relaxed);
+    for (auto _: state) {
+        for (size_t i = 0; i < size; ++i) {
+            auto value = list.getValue(i);
+            auto result = func.call(value.getValue(), Value(static_cast<double>(i)));
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    reportAllocations(state, before, size);
+}
+
+BENCHMARK(BM_MapList)->Arg(1000);
@@ -0,0 +1,105 @@
+// The js-framework-benchmark table, written the way the JSX transform compiles it.
+// EndToEndBenchmark.cpp drives it through the actions published on globalThis.benchmarkActions.
+
+const adjectives = ["pretty", "large", "big", "small", "tall", "short", "long", "handsome", "plain", "quaint",
+    "clean", "elegant", "easy", "angry", "crazy", "helpful", "mushy", "odd", "unsightly", "adorable", "important",
+    "inexpensive", "cheap", "expensive", "fancy"];
+const colours = ["red", "yellow", "blue", "green", "pink", "brown", "purple", "brown", "white", "black", "orange"];
+const nouns = ["table", "chair", "house", "bbq", "desk", "car", "pony", "cookie", "sandwich", "burger", "pizza",
+    "mouse", "keyboard"];
+
+let nextId = 1;
+// Deterministic so every run builds the same labels.
+let seed = 1;
+
+function random(max) {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed % max;
+}
+
+function buildData(count) {
+    const data = new Array(count);
+    for (let i = 0; i < count; i++) {
+        data[i] = {
+            id: nextId++,
+            label: adjectives[random(adjectives.length)] + " " + colours[random(colours.length)] + " " +
+                nouns[random(nouns.length)]
+        };
+    }
+    return data;
+}
+
+function Row({item, selected}) {
+    beginComponentInit("rowBench", 3);
+    {
+        const _parent = createElement("div", {
+            className: selected ? "danger" : "",
+            style: {
+                display: "flex",
+                "flex-direction": "row"
+            }
+        });
+        const _element = createElement("text", {});
+        _element.insertChild(1, String(item.id));
+        _parent.addChild(_element);
+        const _element2 = createElement("text", {});
+        _element2.insertChild(2, item.label);
+        _parent.addChild(_element2);
+        endComponent();
+        return _parent;
+    }
+}
+
+function App() {
+    beginComponentInit("appBench");
+    const [rows, setRows] = useState([]);
+    const [selected, setSelected] = useState(0);
+
+    globalThis.benchmarkActions = {
+        create: count => setRows(buildData(count)),
+        append: count => setRows(prev => prev.concat(buildData(count))),
+        updateEvery: step => setRows(prev => {
+            const next = prev.slice();
+            for (let i = 0; i < next.length; i += step) {
+                next[i] = {id: next[i].id, label: next[i].label + " !!!"};
+            }
+            return next;
+        }),
+        select: index => {
+            const current = toRaw(rows);
+            setSelected(current.length > index ? current[index].id : 0);
+        },
+        swap: (from, to) => setRows(prev => {
+            if (prev.length <= Math.max(from, to)) return prev;
+            const next = prev.slice();
+            const row = next[from];
+            next[from] = next[to];
+            next[to] = row;
+            return next;
+        }),
+        remove: index => setRows(prev => prev.filter((row, i) => i !== index)),
+        clear: () => setRows([])
+    };
+
+    {
+        const _parent = createElement("div", {});
+        const _list = createElement("component", {});
+        effect(() => {
+            const current = toRaw(selected);
+            listConciliar(_list, rows, row => ({
+                "$$internalComponent": false,
+                "component": Row,
+                "key": row.id,
+                "props": {
+                    item: row,
+                    selected: row.id === current
+                }
+            }));
+        }, [rows, selected]);
+        _parent.addChild(_list);
+        endComponent();
+        return _parent;
+    }
+}
+
+render(App);
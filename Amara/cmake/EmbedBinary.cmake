@@ -0,0 +1,15 @@
+# Turns a binary file into a C++ header so it can be linked straight into the executable.
+# Usage: cmake -DINPUT=<file> -DOUTPUT=<header> -DSYMBOL=<name> -P EmbedBinary.cmake
+file(READ "${INPUT}" content HEX)
+string(LENGTH "${content}" hexLength)
+math(EXPR size "${hexLength} / 2")
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${content}")
+get_filename_component(inputName "${INPUT}" NAME)
+file(WRITE "${OUTPUT}"
+        "// Generated from ${inputName}. Do not edit.\n"
+        "#pragma once\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n\n"
+        "// Hermes expects bytecode to be aligned.\n"
+        "alignas(16) static const uint8_t ${SYMBOL}[] = {${bytes}};\n"
+        "static const size_t ${SYMBOL}Size = ${size};\n")
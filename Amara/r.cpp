@@ -1,58 +1,78 @@
-#include <filesystem>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
+#include "runtime/hermes/BundleLoader.h"
 #include "runtime/hermes/InstallEngine.h"
+#include "utils/BridgeStats.h"
+#include "utils/Trace.h"
 
+static double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
 
-std::shared_ptr<StringBuffer> loadFileIntoBuffer(const std::string &filename) {
-    // Get file size efficiently using filesystem
-    std::error_code ec;
-    const auto fileSize = std::filesystem::file_size(filename, ec);
-    if (ec) {
-        std::cerr << "Failed to get size of " << filename << ": " << ec.message() << std::endl;
-        return nullptr;
+int main(int argc, char **argv) {
+    // Defaults to the bytecode the build compiles from f.js, pass a .js path to time the source path instead.
+    const std::string path = argc > 1 ? argv[1] : AMARA_APP_BUNDLE;
+    // AMARA_TRACE=<file> records the session and writes it as a chrome trace.
+    const char *tracePath = std::getenv("AMARA_TRACE");
+    if (tracePath) {
+        Trace::start();
     }
-
-    // Open file in binary mode
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file: " << filename << std::endl;
-        return nullptr;
+    // AMARA_FRAME_STATS=<file> appends a JSON line per frame.
+    std::ofstream frameStats;
+    if (const char *frameStatsPath = std::getenv("AMARA_FRAME_STATS")) {
+        frameStats.open(frameStatsPath, std::ios::app);
     }
+    const auto start = std::chrono::steady_clock::now();
 
-    std::string fileContent;
-    fileContent.resize(fileSize); // Resize the string to accommodate fileSize bytes
-
-    file.read(&fileContent[0], fileSize); // Read directly into the string buffer
-    size_t bytesRead = file.gcount(); // Get actual number of bytes read
-
-    if (file.bad()) {
-        fileContent.clear(); // Clear content if there was an error
-    } else {
-        fileContent.resize(bytesRead); // Resize to actual bytes read
+    auto engine = installEngine();
+    const auto engineReady = std::chrono::steady_clock::now();
+    if (frameStats.is_open()) {
+        engine->setFrameStatsSink(&frameStats);
     }
 
-    if (fileContent.size() != fileSize) {
-        std::cerr << "Error reading file: Expected " << fileSize << " bytes, got " << fileContent.size() << std::endl;
-        return nullptr;
+    BundleLoader loader;
+    auto bundle = loader.load(path);
+    if (!bundle) {
+        return 1;
     }
-    // Return the buffer with moved content to avoid copying
-    return std::make_shared<StringBuffer>(std::move(fileContent));
-}
-
-int main() {
-    auto hbc = loadFileIntoBuffer("../../f.js");
-    auto engine = installEngine();
+    const auto bundleLoaded = std::chrono::steady_clock::now();
 
     try {
-
-        engine->execute(std::move(hbc));
-
+        // The bundle calls render() itself, so once execute returns the first frame is done.
+        engine->execute(*bundle);
     } catch (JSError &error) {
         std::cout << error.getMessage() << "\n" << error.getStack() << std::endl;
     }
+    const auto firstRender = std::chrono::steady_clock::now();
+
+    std::cout << "Time to first render (" << (bundle->isBytecode ? "bytecode" : "source") << "): "
+            << elapsedMs(start, firstRender) << " ms [engine " << elapsedMs(start, engineReady)
+            << " ms, load " << elapsedMs(engineReady, bundleLoaded)
+            << " ms, execute " << elapsedMs(bundleLoaded, firstRender) << " ms]" << std::endl;
+    if (engine->pendingAfterRender()) {
+        std::cerr << "State updates still pending after " << engine->renderFrames() << " frames" << std::endl;
+    }
+
+    if (BridgeStats::enabled()) {
+        BridgeStats::report(std::cout);
+    }
+
+    if (tracePath) {
+        Trace::stop();
+        if (!Trace::writeChromeTrace(tracePath)) {
+            std::cerr << "Couldn't write the trace to " << tracePath << std::endl;
+        }
+    }
 
+    // render() leaves the tree mounted so hosts can keep ticking it.
+    if (engine->root()) {
+        engine->root()->printTree();
+    }
+    engine->setFrameStatsSink(nullptr);
+    engine->shutdown();
     engine.reset();
     return 0;
 }
@@ -17,6 +17,6 @@ public:
 
     virtual size_t size() =0;
 
-    virtual StateWrapperRef getValue(size_t index) =0;
+    virtual StateWrapper getValue(size_t index) =0;
 };
 #endif //AMARAARRAY_H
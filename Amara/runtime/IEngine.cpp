@@ -0,0 +1,107 @@
+#include "IEngine.h"
+
+#include "../ui/ComponentContext.h"
+#include "../utils/BridgeStats.h"
+#include "../utils/Trace.h"
+
+void IEngine::setViewport(float width, float height) {
+    viewportWidth = width;
+    viewportHeight = height;
+    if (auto root = this->root()) root->markLayoutDirty();
+}
+
+bool IEngine::layout() {
+    auto root = this->root();
+    if (!root) return false;
+    TRACE_SCOPE(Layout, "layout");
+    for (const auto handle: layoutChildChanges) {
+        if (auto widget = pool.resolve(handle)) widget->syncLayoutChildren();
+    }
+    layoutChildChanges.clear();
+    auto &node = root->layoutNode();
+    if (!node.isDirty()) return false;
+    // Masharif only visits dirty subtrees and answers the rest from its measurement cache.
+    node.calculateLayout(viewportWidth, viewportHeight);
+    return true;
+}
+
+FrameResult IEngine::tick(FrameClock::duration budget) {
+    TRACE_SCOPE(Frame, "frame");
+    const auto before = snapshot();
+    auto result = scheduler.runFrame(budget);
+    TRACE_COUNTER(Frame, "updates", static_cast<double>(result.updated));
+    TRACE_COUNTER(Frame, "deferred", static_cast<double>(result.deferred));
+    result.laidOut = layout();
+    result.reclaimed = reclaim.drain(reclaimBudget);
+    trimWhenIdle(result);
+    finishFrame(before, result);
+    return result;
+}
+
+size_t IEngine::onMemoryPressure() {
+    reclaim.drainAll();
+    const size_t before = pool.stats().bytesReclaimed;
+    pool.trim(0);
+    return pool.stats().bytesReclaimed - before;
+}
+
+IEngine::FrameSnapshot IEngine::snapshot() {
+    const bool withGc = frameStatsSink || collectGcStats;
+    return {
+        FrameClock::now(), engineCounters, pool.stats(), BridgeStats::totalCalls(), withGc ? gcStats() : GcStats{}
+    };
+}
+
+void IEngine::trimWhenIdle(const FrameResult &result) {
+    if (result.updated != 0 || scheduler.hasPendingWork() || !reclaim.empty()) {
+        idleFrames = 0;
+        return;
+    }
+    const size_t trimAfter = pool.policy().idleFramesBeforeTrim;
+    if (trimAfter != 0 && ++idleFrames == trimAfter) {
+        TRACE_SCOPE(Frame, "trimWidgetPool");
+        pool.trim(pool.policy().prewarm);
+    }
+}
+
+void IEngine::finishFrame(const FrameSnapshot &before, const FrameResult &result) {
+    const auto after = snapshot();
+    FrameStats stats;
+    stats.frame = frameStats.frame + 1;
+    stats.durationMs = std::chrono::duration<double, std::milli>(after.start - before.start).count();
+    stats.componentsUpdated = result.updated;
+    stats.effectsRun = after.counters.effectsRun - before.counters.effectsRun;
+    stats.widgetsCreated = after.pool.allocated - before.pool.allocated;
+    stats.widgetsReused = after.pool.reused - before.pool.reused;
+    stats.widgetsFreed = after.pool.released - before.pool.released;
+    stats.bytesReclaimed = after.pool.bytesReclaimed - before.pool.bytesReclaimed;
+    stats.widgetsUnmounted = result.reclaimed;
+    stats.reclaimBacklog = reclaim.size();
+    for (size_t i = 0; i < CHILD_OP_KIND_COUNT; ++i) {
+        stats.childOps[i] = after.counters.childOps[i] - before.counters.childOps[i];
+    }
+    stats.jsiCalls = after.jsiCalls - before.jsiCalls;
+    stats.gcCollections = after.gc.collections - before.gc.collections;
+    stats.gcPauseMs = after.gc.pauseMs - before.gc.pauseMs;
+    frameStats = stats;
+    if (frameStatsSink) writeFrameStatsJson(*frameStatsSink, frameStats);
+}
+
+void IEngine::adoptComponent(std::shared_ptr<ComponentContext> component) {
+    component->mountedIndex = mountedComponents.size();
+    mountedComponents.push_back(std::move(component));
+}
+
+void IEngine::unmountComponent(ComponentContext &component) {
+    component.unmount();
+    auto owned = component.shared_from_this();
+    const size_t index = component.mountedIndex;
+    if (index != ComponentContext::NOT_MOUNTED) {
+        // Swapped with the last one, the order of the mounted components doesn't matter.
+        std::swap(mountedComponents[index], mountedComponents.back());
+        mountedComponents[index]->mountedIndex = index;
+        mountedComponents.pop_back();
+        component.mountedIndex = ComponentContext::NOT_MOUNTED;
+    }
+    reclaim.push(std::move(owned));
+}
@@ -3,7 +3,13 @@
 #include <complex.h>
 #include <stack>
 
+#include "PropDiff.h"
 #include "../utils/WidgetPool.h"
+#include "../utils/css/StyleCache.h"
+#include "../ui/FrameStats.h"
+#include "../ui/ListReconciler.h"
+#include "../ui/ReclaimQueue.h"
+#include "../ui/UpdateScheduler.h"
 #include "hermes/HermesPropMap.h"
 
 class IEngine {
@@ -14,7 +20,8 @@ public:
 
     virtual void endComponentImpl() =0;
 
-    virtual std::shared_ptr<Widget> createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) =0;
+    // The widget is owned by the component on top of the context stack.
+    virtual Widget *createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) =0;
 
     virtual void installFunctions() =0;
 
@@ -24,9 +31,9 @@ public:
 
     virtual void pushExistingComponent(std::shared_ptr<ComponentContext> context) =0;
 
-    virtual SharedWidget findSharedWidget(StateWrapperRef &widgetVariable) =0;
+    virtual Widget *findWidget(StateWrapper &widgetVariable) =0;
 
-    virtual std::unique_ptr<WidgetHolder> getWidgetHolder(StateWrapperRef &widgetVariable) =0;
+    virtual std::unique_ptr<WidgetHolder> getWidgetHolder(StateWrapper &widgetVariable) =0;
 
     void plugComponent(const std::shared_ptr<ComponentContext> &component) {
         contextStack.emplace(component);
@@ -36,12 +43,132 @@ public:
         contextStack.pop();
     };
 
-    virtual void compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) =0;
+    // Mounted components are owned here, widgets only point at theirs.
+    void adoptComponent(std::shared_ptr<ComponentContext> component);
+
+    // Runs the component's cleanups and hands it from the mounted components to the ReclaimQueue.
+    void unmountComponent(ComponentContext &component);
+
+    virtual PropDiff compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) =0;
+
+    StyleCache &styles() {
+        return styleCache;
+    }
+
+    void setViewport(float width, float height);
+
+    // Lays out whatever changed since the last call, returns false if nothing did.
+    bool layout();
+
+    // Widgets whose children changed, their layout nodes are rebuilt once before the next layout.
+    void queueLayoutChildren(WidgetHandle widget) {
+        layoutChildChanges.push_back(widget);
+    }
+
+    // One frame: pending component updates within the budget, then layout. Hosts call this once per vsync.
+    FrameResult tick(FrameClock::duration budget = DEFAULT_FRAME_BUDGET);
+
+    void setPoolPolicy(const WidgetPoolPolicy &policy) {
+        pool.setPolicy(policy);
+    }
+
+    // Time each frame spends freeing unmounted widgets, whatever doesn't fit waits for the next frame.
+    void setReclaimBudget(FrameClock::duration budget) {
+        reclaimBudget = budget;
+    }
+
+    ReclaimQueue &reclaimer() {
+        return reclaim;
+    }
+
+    // For the host's low memory notification: frees every unmounted widget and gives back every free widget slot
+    // that can be released. Returns the bytes reclaimed.
+    size_t onMemoryPressure();
+
+    // What the last tick() did. Work render() does before its first tick isn't part of any frame.
+    const FrameStats &lastFrameStats() const {
+        return frameStats;
+    }
+
+    // Writes every frame's stats to `out` as a JSON line, nullptr stops it.
+    void setFrameStatsSink(std::ostream *out) {
+        frameStatsSink = out;
+    }
+
+    // GC stats cost a call into the runtime per frame, they are read only when a sink is set or this asks for them.
+    void setCollectGcStats(bool collect) {
+        collectGcStats = collect;
+    }
+
+    EngineCounters &counters() {
+        return engineCounters;
+    }
+
+    // Totals since the engine started, engines without collector stats report zeros.
+    virtual GcStats gcStats() {
+        return {};
+    }
+
+    // Scheduled updates or unmounted widgets still to free, either way the host should keep ticking.
+    bool hasPendingWork() const {
+        return scheduler.hasPendingWork() || !reclaim.empty();
+    }
+
+    UpdateScheduler &updates() {
+        return scheduler;
+    }
+
+    ListReconcileScratchPool &listScratch() {
+        return listScratchPool;
+    }
+
+    Widget *root() const {
+        return pool.resolve(rootWidget);
+    }
+
+    const WidgetPoolStats &poolStats() const {
+        return pool.stats();
+    }
+
+    Widget *resolveWidget(WidgetHandle handle) const {
+        return pool.resolve(handle);
+    }
 
 protected:
-    SharedWidget rootWidget;
+    struct FrameSnapshot {
+        FrameClock::time_point start;
+        EngineCounters counters;
+        WidgetPoolStats pool;
+        uint64_t jsiCalls;
+        GcStats gc;
+    };
+
+    FrameSnapshot snapshot();
+
+    void trimWhenIdle(const FrameResult &result);
+
+    void finishFrame(const FrameSnapshot &before, const FrameResult &result);
+
+    // Owned by the root component like any other widget.
+    WidgetHandle rootWidget;
+    StyleCache styleCache;
+    UpdateScheduler scheduler;
+    ListReconcileScratchPool listScratchPool;
+    std::vector<WidgetHandle> layoutChildChanges;
+    float viewportWidth = 800;
+    float viewportHeight = 600;
     WidgetPool pool;
+    // After the pool, so widgets still queued at teardown go before it.
+    ReclaimQueue reclaim{pool};
+    FrameClock::duration reclaimBudget = DEFAULT_RECLAIM_BUDGET;
+    EngineCounters engineCounters;
+    FrameStats frameStats;
+    size_t idleFrames = 0;
+    std::ostream *frameStatsSink = nullptr;
+    bool collectGcStats = false;
     std::stack<std::shared_ptr<ComponentContext> > contextStack;
+    // After the pool, so they go first at teardown. Indexed by ComponentContext::mountedIndex.
+    std::vector<std::shared_ptr<ComponentContext> > mountedComponents;
     std::stack<std::shared_ptr<ComponentContext> > componentContextFactory;
 };
 #endif
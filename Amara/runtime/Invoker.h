@@ -6,7 +6,7 @@
 class Invoker {
 public:
 
-    virtual void invoke(std::initializer_list<StateWrapperRef>  wrapper) =0;
+    virtual void invoke(std::initializer_list<StateWrapper>  wrapper) =0;
 };
 
 
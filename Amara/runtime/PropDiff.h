@@ -0,0 +1,40 @@
+#ifndef PROPDIFF_H
+#define PROPDIFF_H
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class PropChangeKind : unsigned char {
+    Added,
+    Removed,
+    Changed
+};
+
+struct PropChange {
+    // Dotted path for nested objects, e.g. "style.width".
+    std::string key;
+    PropChangeKind kind;
+};
+
+/**
+ * Result of comparing two prop objects. `children` is never reported since children are reconciled separately.
+ */
+struct PropDiff {
+    std::vector<PropChange> changes;
+
+    [[nodiscard]] bool empty() const {
+        return changes.empty();
+    }
+
+    // True if the given top level prop (or anything nested inside it) changed.
+    [[nodiscard]] bool touches(std::string_view prop) const {
+        for (const auto &change: changes) {
+            std::string_view key = change.key;
+            if (key.compare(0, prop.size(), prop) == 0 && (key.size() == prop.size() || key[prop.size()] == '.')) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+#endif //PROPDIFF_H
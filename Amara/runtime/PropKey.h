@@ -0,0 +1,42 @@
+#ifndef PROPKEY_H
+#define PROPKEY_H
+#include <cstddef>
+
+// Every property name the engine reads on its own. Engines intern these once so lookups never go through strings.
+#define AMARA_DESCRIPTOR_KEYS(X) \
+    X(InternalComponent, "$$internalComponent") \
+    X(Component, "component") \
+    X(Props, "props") \
+    X(Key, "key") \
+    X(Slot, "slot") \
+    X(Children, "children") \
+    X(Style, "style") \
+    X(Ref, "ref") \
+    X(IsStateVariable, "_isStateVariable") \
+    X(Value, "value") \
+    X(SetValue, "setValue") \
+    X(ToString, "toString") \
+    X(Bind, "bind")
+
+// Style keys aren't interned, styles are enumerated once and dispatched through StyleProperty.h instead.
+#define AMARA_PROP_KEYS(X) AMARA_DESCRIPTOR_KEYS(X)
+
+enum class PropKey : unsigned short {
+#define AMARA_PROP_KEY_ENUM(name, string) name,
+    AMARA_PROP_KEYS(AMARA_PROP_KEY_ENUM)
+#undef AMARA_PROP_KEY_ENUM
+    Count
+};
+
+constexpr size_t PROP_KEY_COUNT = static_cast<size_t>(PropKey::Count);
+
+inline const char *propKeyName(PropKey key) {
+    static constexpr const char *names[] = {
+#define AMARA_PROP_KEY_NAME(name, string) string,
+        AMARA_PROP_KEYS(AMARA_PROP_KEY_NAME)
+#undef AMARA_PROP_KEY_NAME
+    };
+    return names[static_cast<size_t>(key)];
+}
+
+#endif //PROPKEY_H
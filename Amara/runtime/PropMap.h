@@ -1,9 +1,12 @@
 #ifndef PROPMAP_H
 #define PROPMAP_H
+#include <functional>
 #include <string>
+#include <string_view>
 #include <memory>
 
 #include "AmaraArray.h"
+#include "PropKey.h"
 
 class PropMap {
 public:
@@ -30,5 +33,33 @@ public:
     virtual void set(const std::string &key, std::unique_ptr<PropMap> &map) const = 0;
 
     virtual void set(const std::string &key, const std::string &value) const = 0;
+
+    // Interned lookups for the keys the engine knows about. Prefer these on hot paths.
+    virtual double getNumber(PropKey key, double defaultValue = 0) const = 0;
+
+    virtual std::string getString(PropKey key, const std::string &defaultValue = "") const = 0;
+
+    virtual bool getBool(PropKey key, bool defaultValue = false) const = 0;
+
+    virtual std::unique_ptr<PropMap> getObject(PropKey key) const = 0;
+
+    virtual std::unique_ptr<AmaraArray> getArray(PropKey key) const = 0;
+
+    virtual bool has(PropKey key) const = 0;
+
+    // Writes values the map deferred into the underlying object, see HermesPropMap::defer.
+    virtual void flush() const {
+    }
+
+    // An entry forEachEntry visits. Numbers are passed as is, strings as their text, both only live for the call.
+    struct Entry {
+        std::string_view key;
+        bool isNumber;
+        double number;
+        std::string_view text;
+    };
+
+    // Visits every own key with a string or number value once, in insertion order.
+    virtual void forEachEntry(const std::function<void(const Entry &entry)> &fn) const = 0;
 };
 #endif //PROPMAP_H
@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "PropMap.h"
+#include "../ui/ChildSlot.h"
 #include "../ui/Key.h"
 class Widget;
 class IEngine;
@@ -15,26 +16,27 @@ public:
     };
 
     WidgetHolder(std::optional<std::string> componentName, std::unique_ptr<PropMap> props,
-                 std::optional<std::string> id,
+                 ChildSlot slot,
                  const Key &key = Key()): componentName(std::move(componentName)), _props(std::move(props)),
-                                          id(std::move(id)), _key(key) {
+                                          _slot(slot), _key(key) {
         isInternal = true;
     }
 
     virtual ~WidgetHolder() = default;
 
-    virtual std::shared_ptr<Widget> execute(IEngine *) =0;
+    // The widget is owned by the component that created it.
+    virtual Widget *execute(IEngine *) =0;
 
     bool isComponent() {
         return !isInternal;
     }
 
-    bool hasID() {
-        return id.has_value();
+    bool hasSlot() const {
+        return _slot != NO_CHILD_SLOT;
     }
 
-    std::string &getID() {
-        return id.value();
+    ChildSlot slot() const {
+        return _slot;
     }
 
     Key &key() {
@@ -53,11 +55,11 @@ public:
         return _props;
     }
 
-    virtual bool sameComponent(StateWrapperRef &other) =0;
+    virtual bool sameComponent(StateWrapper &other) =0;
 
 protected:
     bool isInternal = false;
-    std::optional<std::string> id;
+    ChildSlot _slot = NO_CHILD_SLOT;
     //Usable only for internal widgets
     std::optional<std::string> componentName;
     std::unique_ptr<PropMap> _props;
@@ -0,0 +1,189 @@
+#include "BundleLoader.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <hermes/hermes.h>
+#include <hermes/CompileJS.h>
+
+#include "AmaraPrelude.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using facebook::hermes::HermesRuntime;
+
+std::shared_ptr<MappedFileBuffer> MappedFileBuffer::map(const std::string &path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The mapping keeps the file alive.
+    CloseHandle(file);
+    if (!mapping) return nullptr;
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    return std::shared_ptr<MappedFileBuffer>(
+        new MappedFileBuffer(static_cast<const uint8_t *>(data), static_cast<size_t>(fileSize.QuadPart), mapping));
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+    return std::shared_ptr<MappedFileBuffer>(
+        new MappedFileBuffer(static_cast<const uint8_t *>(data), static_cast<size_t>(st.st_size), nullptr));
+#endif
+}
+
+MappedFileBuffer::~MappedFileBuffer() {
+#if defined(_WIN32)
+    UnmapViewOfFile(_data);
+    CloseHandle(handle);
+#else
+    munmap(const_cast<uint8_t *>(_data), _size);
+#endif
+}
+
+static bool readFile(const std::string &path, std::string &content) {
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        std::cerr << "Failed to get size of " << path << ": " << ec.message() << std::endl;
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return false;
+    }
+    content.resize(fileSize);
+    file.read(&content[0], static_cast<std::streamsize>(fileSize));
+    if (file.bad() || static_cast<size_t>(file.gcount()) != fileSize) {
+        std::cerr << "Error reading file: Expected " << fileSize << " bytes, got " << file.gcount() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// False if the file couldn't be opened or any byte failed to reach it, e.g. on a full disk.
+static bool writeFile(const std::string &path, const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    file.close();
+    return !file.fail();
+}
+
+// FNV-1a. The bytecode version is mixed in so upgrading hermes never picks up stale bytecode.
+static uint64_t hashSource(const std::string &source) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+    for (char c: source) mix(static_cast<uint8_t>(c));
+    const uint32_t version = HermesRuntime::getBytecodeVersion();
+    for (int i = 0; i < 4; ++i) mix(static_cast<uint8_t>(version >> (i * 8)));
+    return hash;
+}
+
+static bool isUsableBytecode(const Buffer &buffer) {
+    return HermesRuntime::isHermesBytecode(buffer.data(), buffer.size()) &&
+           HermesRuntime::hermesBytecodeSanityCheck(buffer.data(), buffer.size());
+}
+
+BundleLoader::BundleLoader(std::string cacheDirectory) : cacheDirectory(std::move(cacheDirectory)) {
+}
+
+std::string BundleLoader::defaultCacheDirectory() {
+    std::error_code ec;
+    auto temp = std::filesystem::temp_directory_path(ec);
+    if (ec) return "";
+    return (temp / "amara-bytecode-cache").string();
+}
+
+std::optional<Bundle> BundleLoader::load(const std::string &path) const {
+    auto mapped = MappedFileBuffer::map(path);
+    if (!mapped) {
+        std::cerr << "Failed to map " << path << std::endl;
+        return std::nullopt;
+    }
+    if (HermesRuntime::isHermesBytecode(mapped->data(), mapped->size())) {
+        HermesRuntime::prefetchHermesBytecode(mapped->data(), mapped->size());
+        return Bundle{std::move(mapped), path, true};
+    }
+    return loadSource(path);
+}
+
+std::optional<Bundle> BundleLoader::loadSource(const std::string &path) const {
+    std::string source;
+    if (!readFile(path, source)) {
+        return std::nullopt;
+    }
+    if (cacheDirectory.empty()) {
+        return Bundle{std::make_shared<StringBuffer>(std::move(source)), path, false};
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.hbc", static_cast<unsigned long long>(hashSource(source)));
+    const auto cachePath = std::filesystem::path(cacheDirectory) / name;
+
+    std::error_code ec;
+    if (std::filesystem::exists(cachePath, ec)) {
+        auto cached = MappedFileBuffer::map(cachePath.string());
+        if (cached && isUsableBytecode(*cached)) {
+            return Bundle{std::move(cached), path, true};
+        }
+        // Truncated or corrupt, compiled again below and replaced.
+        cached.reset();
+        std::filesystem::remove(cachePath, ec);
+    }
+
+    std::string bytecode;
+    if (!::hermes::compileJS(source, bytecode, true)) {
+        // Let the runtime report the syntax error against the original source.
+        return Bundle{std::make_shared<StringBuffer>(std::move(source)), path, false};
+    }
+
+    std::filesystem::create_directories(cacheDirectory, ec);
+    // Write then rename so a concurrent launch never maps a half written file.
+    const auto tempPath = cachePath.string() + ".tmp";
+    if (writeFile(tempPath, bytecode)) {
+        std::filesystem::rename(tempPath, cachePath, ec);
+    } else {
+        std::cerr << "Failed to write the bytecode cache " << tempPath << std::endl;
+        ec = std::make_error_code(std::errc::io_error);
+    }
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+    return Bundle{std::make_shared<StringBuffer>(std::move(bytecode)), path, true};
+}
+
+Bundle BundleLoader::prelude() {
+    return Bundle{std::make_shared<StaticBuffer>(kAmaraPrelude, kAmaraPreludeSize), "internalFunctions.js", true};
+}
@@ -0,0 +1,88 @@
+#ifndef BUNDLELOADER_H
+#define BUNDLELOADER_H
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <jsi/jsi.h>
+using namespace facebook::jsi;
+
+/**
+ * Read-only view over a memory mapped file. Hermes executes bytecode straight out of the mapping, so the pages are
+ * only touched when a function is actually run.
+ */
+class MappedFileBuffer : public Buffer {
+public:
+    ~MappedFileBuffer() override;
+
+    static std::shared_ptr<MappedFileBuffer> map(const std::string &path);
+
+    size_t size() const override {
+        return _size;
+    }
+
+    const uint8_t *data() const override {
+        return _data;
+    }
+
+private:
+    MappedFileBuffer(const uint8_t *data, size_t size, void *handle) : _data(data), _size(size), handle(handle) {
+    }
+
+    const uint8_t *_data;
+    size_t _size;
+    // File mapping handle on windows, unused on posix.
+    void *handle;
+};
+
+/**
+ * Non owning buffer over data baked into the binary (e.g. the precompiled prelude).
+ */
+class StaticBuffer : public Buffer {
+public:
+    StaticBuffer(const uint8_t *data, size_t size) : _data(data), _size(size) {
+    }
+
+    size_t size() const override {
+        return _size;
+    }
+
+    const uint8_t *data() const override {
+        return _data;
+    }
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+};
+
+struct Bundle {
+    std::shared_ptr<const Buffer> buffer;
+    std::string sourceURL;
+    bool isBytecode = false;
+};
+
+class BundleLoader {
+public:
+    // An empty cache directory disables the bytecode cache for source bundles.
+    explicit BundleLoader(std::string cacheDirectory = defaultCacheDirectory());
+
+    /**
+     * Loads either a precompiled HBC file (mapped zero-copy) or a JS source file. Sources are compiled once and the
+     * bytecode is kept on disk keyed by the hash of the source, so the next launch maps the cached file instead.
+     */
+    std::optional<Bundle> load(const std::string &path) const;
+
+    // The JS side of the runtime (internalFunctions.js), precompiled at build time and embedded in the binary.
+    static Bundle prelude();
+
+    static std::string defaultCacheDirectory();
+
+private:
+    std::optional<Bundle> loadSource(const std::string &path) const;
+
+    std::string cacheDirectory;
+};
+
+#endif //BUNDLELOADER_H
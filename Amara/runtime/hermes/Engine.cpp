@@ -4,7 +4,7 @@
 
 #include "Engine.h"
 
-#include <iostream>
+#include <cmath>
 
 #include "WidgetHostWrapper.h"
 #include <hermes/hermes.h>
@@ -12,7 +12,10 @@
 #include "HermesArray.h"
 #include "HermesPropMap.h"
 #include "HermesWidgetHolder.h"
-#include "../../utils/ScopedTimer.h"
+#include "PropDiffer.h"
+#include "StateCell.h"
+#include "../../utils/BridgeStats.h"
+#include "../../utils/Trace.h"
 
 void HermesEngine::beginComponentImpl() {
     if (!_started) {
@@ -24,7 +27,10 @@ void HermesEngine::beginComponentImpl() {
         componentContextFactory.pop();
         return;
     }
-    contextStack.emplace(std::make_shared<ComponentContext>(this));
+    const size_t depth = contextStack.empty() ? 0 : contextStack.top()->depth() + 1;
+    auto context = std::make_shared<ComponentContext>(this, depth);
+    adoptComponent(context);
+    contextStack.emplace(std::move(context));
 }
 
 void HermesEngine::endComponentImpl() {
@@ -42,18 +48,15 @@ void HermesEngine::componentEffectImpl(Value fn, const Value &deps) {
     }
     auto &context = contextStack.top();
 
-    std::vector<StateWrapperRef> depsVector;
+    std::vector<StateWrapper> depsVector;
     if (!deps.isUndefined()) {
         auto arr = deps.asObject(*runtime).asArray(*runtime);
         auto size = arr.size(*runtime);
         depsVector.reserve(size);
         for (int i = 0; i < size; ++i) {
             Value v = arr.getValueAtIndex(*runtime, i);
-            // In case the used variable was some sort of primitive, We can ignore it.
-            if (!v.isObject()) continue;
-            if (v.asObject(*runtime).getProperty(*runtime, "_isStateVariable").isUndefined()) {
-                continue;
-            }
+            // Only state variables can change, anything else in the deps can be ignored.
+            if (!StateCell::is(*runtime, v)) continue;
             auto stateVariable = StateWrapper::create(*runtime, std::move(v));
             depsVector.emplace_back(std::move(stateVariable));
         }
@@ -69,32 +72,32 @@ Value HermesEngine::useStateImpl(const Value &value) {
     }
 
     auto &rt = *runtime;
-    auto createElementRef = rt.global().getProperty(rt, "createRef").asObject(rt).asFunction(rt);
-
 
-    auto createStateWrapper = [&](const Value &val) -> std::unique_ptr<StateWrapper> {
+    auto createStateWrapper = [&](const Value &val) -> StateWrapper {
+        Value initial(rt, val);
         if (val.isObject()) {
             auto obj = val.asObject(rt);
             if (obj.isFunction(rt)) {
-                auto resolvedValue = obj.asFunction(rt).call(rt);
-                auto proxy = createElementRef.call(rt, resolvedValue);
-                return StateWrapper::create(rt, std::move(proxy));
+                BridgeScope scope(BridgeCall::CallStateInitializer);
+                initial = obj.asFunction(rt).call(rt);
             }
         }
-        auto proxy = createElementRef.call(rt, val);
-        return StateWrapper::create(rt, std::move(proxy));
+        auto cell = std::make_shared<StateCell>(*cellMethods, std::move(initial));
+        return StateWrapper::create(rt, Object::createFromHostObject(rt, std::move(cell)));
     };
 
-    auto wrapper = createStateWrapper(value);
     auto context = contextStack.top();
+    // Re-executed components get their existing cells back, the initial value is only needed on mount.
+    auto wrapper = context->reconciliationStarted() ? StateWrapper() : createStateWrapper(value);
 
     auto [stateValue, func] = context->useState(std::move(wrapper), [this, context=std::move(context)] {
-        nextIterationComponents.emplace_back(context);
+        scheduler.schedule(context);
     });
 
 
     auto setter = [this,func=std::move(func)](Runtime &rt, const Value &thisValue, const Value *args,
                                               const size_t count) {
+        BridgeScope scope(BridgeCall::SetState);
         if (count != 1) {
             throw JSINativeException("setState requires exactly one argument");
         }
@@ -105,77 +108,61 @@ Value HermesEngine::useStateImpl(const Value &value) {
 
     return Array::createWithElements(
         rt,
-        stateValue->getValue(),
+        std::move(stateValue),
         Function::createFromHostFunction(rt, PropNameID::forAscii(rt, "setState"), 1, setter)
     );
 }
 
-std::shared_ptr<Widget> HermesEngine::createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) {
+Widget *HermesEngine::createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) {
     SharedWidget widget;
     if (type == "component" || type == "div") {
-        widget = pool.allocate<ContainerWidget>(std::move(propsMap), contextStack.top());
+        widget = pool.allocate<ContainerWidget>(std::move(propsMap), contextStack.top().get());
     } else if (type == "text" || type == "h1" || type == "h2") {
-        widget = pool.allocate<TextWidget>(std::move(propsMap), contextStack.top());
+        widget = pool.allocate<TextWidget>(std::move(propsMap), contextStack.top().get());
     } else if (type == "image") {
-        widget = pool.allocate<ImageWidget>(std::move(propsMap), contextStack.top());
+        widget = pool.allocate<ImageWidget>(std::move(propsMap), contextStack.top().get());
     } else if (type == "button") {
-        widget = pool.allocate<ButtonWidget>(std::move(propsMap), contextStack.top());
+        widget = pool.allocate<ButtonWidget>(std::move(propsMap), contextStack.top().get());
     } else if (type == "holder") {
-        widget = pool.allocate<HolderWidget>(std::move(propsMap), contextStack.top());
+        widget = pool.allocate<HolderWidget>(std::move(propsMap), contextStack.top().get());
     } else {
         throw JSError(*runtime, "Unknown component type: " + type);
     }
-    contextStack.top()->widgets.push_back(widget);
-    return widget;
+    contextStack.top()->addWidget(widget);
+    return widget.get();
 }
 
 void HermesEngine::render(const Value &value) {
-    ScopedTimer timer;
+    TRACE_SCOPE(Render, "render");
     _started = true;
     auto &rt = *runtime;
     const auto func = value.asObject(rt).asFunction(rt);
 
-    const auto result = func.call(rt);
+    const auto result = [&] {
+        BridgeScope scope(BridgeCall::CallComponent);
+        TRACE_SCOPE(Js, "component");
+        return func.call(rt);
+    }();
 
     if (!result.isObject()) {
         throw JSINativeException("Your initial function did something wrong");
     }
 
-    rootWidget = std::move(result.asObject(rt).asHostObject<WidgetHostWrapper>(rt)->getNativeWidget());
-
-    //moving the edited components to the next iteration component
-    componentsToBeUpdated.insert(componentsToBeUpdated.end(), nextIterationComponents.begin(),
-                                 nextIterationComponents.end());
-    nextIterationComponents.clear();
-    for (int i = 0; i < 3; i++) {
-        std::sort(componentsToBeUpdated.begin(), componentsToBeUpdated.end(),
-                  [](const std::shared_ptr<ComponentContext> &first, const std::shared_ptr<ComponentContext> &second) {
-                      return first->index() < second->index();
-                  });
-        for (auto &c: componentsToBeUpdated) {
-            c->update();
-        }
-        if (nextIterationComponents.empty()) {
-            std::cout << "ENDED EARLY At iteration" << i << std::endl;
-            //       delete iter;
-            break;
-        }
-        componentsToBeUpdated.clear();
-        componentsToBeUpdated.insert(componentsToBeUpdated.end(), nextIterationComponents.begin(),
-                                     nextIterationComponents.end());
-
-        nextIterationComponents.clear();
-        //Basically, dirty is reset to false after the first update call.
-        for (auto &element: componentsToBeUpdated) {
-            element->markDirty();
-        }
+    auto root = result.asObject(rt).asHostObject<WidgetHostWrapper>(rt)->getNativeWidget();
+    rootWidget = root->handle();
+    root->component()->setRootWidget(rootWidget);
+    layout();
+
+    _renderFrames = 0;
+    while (scheduler.hasPendingWork() && _renderFrames < MAX_RENDER_FRAMES) {
+        tick();
+        ++_renderFrames;
     }
-    rootWidget->printTree();
-    rootWidget->resetPointer();
+    _pendingAfterRender = scheduler.hasPendingWork();
 }
 
-SharedWidget HermesEngine::findSharedWidget(StateWrapperRef &widgetVariable) {
-    return widgetVariable->getValue().asObject(*runtime).asHostObject<WidgetHostWrapper>(*runtime)->getNativeWidget();
+Widget *HermesEngine::findWidget(StateWrapper &widgetVariable) {
+    return widgetVariable.getValue().asObject(*runtime).asHostObject<WidgetHostWrapper>(*runtime)->getNativeWidget();
 }
 
 void HermesEngine::componentEffectImpl(const Value &value) {
@@ -190,13 +177,13 @@ void HermesEngine::pushExistingComponent(const std::shared_ptr<ComponentContext>
 
 void HermesEngine::listConciliar(const shared_ptr<WidgetHostWrapper> &widgetWrapper, Value arr, Value func) {
     auto widget = widgetWrapper->getNativeWidget();
-    if (!arr.asObject(*runtime).getProperty(*runtime, "_isStateVariable").isUndefined()) {
-        arr = arr.asObject(*runtime).getProperty(*runtime, "value");
+    if (const auto cell = StateCell::from(*runtime, arr)) {
+        arr = Value(*runtime, cell->current());
     }
     //It's okay if the component still there, but this is very important for the cases where we reconcile without recreating the component
-    contextStack.emplace(widget->component());
+    contextStack.emplace(widget->component()->shared_from_this());
     auto functionWrapper = StateWrapper::create(*runtime, std::move(func));
-    widget->component()->reconcileList(widget, std::make_unique<HermesArray>(*runtime, std::move(arr)),
+    widget->component()->reconcileList(*widget, std::make_unique<HermesArray>(*runtime, std::move(arr)),
                                        std::move(functionWrapper));
 
     contextStack.pop();
@@ -204,10 +191,13 @@ void HermesEngine::listConciliar(const shared_ptr<WidgetHostWrapper> &widgetWrap
 
 void HermesEngine::installFunctions() {
     auto &rt = *runtime;
+    hostMethods = std::make_unique<WidgetHostMethods>(rt);
+    cellMethods = std::make_unique<StateCellMethods>(rt, *names);
 
     DEFINE_GLOBAL_FUNCTION("render", 0,
                            [this](Runtime &rt, const Value &thisVal, const Value *args,size_t count) -> Value {
 
+                           BridgeScope scope(BridgeCall::Render);
                            if (count == 0) {
                            throw JSINativeException("render requires at least one argument");
                            }
@@ -217,6 +207,7 @@ void HermesEngine::installFunctions() {
 
     DEFINE_GLOBAL_FUNCTION("shutdown", 2,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::Shutdown);
                            shutdown();
                            return Value::undefined();
                            });
@@ -225,15 +216,16 @@ void HermesEngine::installFunctions() {
                                       rt, PropNameID::forAscii(rt, "createElement"), 2,
                                       [this](Runtime &rt, const Value &thisVal, const Value *args,
                                              size_t count) -> Value {
+                                          BridgeScope scope(BridgeCall::CreateElement);
                                           if (count < 2 || !args[0].isString() || !args[1].isObject()) {
                                               throw JSError(rt, "Invalid arguments for createElement");
                                           }
                                           std::string type = args[0].asString(rt).utf8(rt);
                                           auto &props = args[1];
-                                          auto propsMap = std::make_unique<HermesPropMap>(rt, Value(rt,props));
+                                          auto propsMap = std::make_unique<HermesPropMap>(rt, *names, Value(rt,props));
                                           auto widget = createComponent(
                                               type, std::move(propsMap));
-                                          const auto wrapper = std::make_shared<WidgetHostWrapper>(this, widget);
+                                          const auto wrapper = std::make_shared<WidgetHostWrapper>(this, widget->handle());
                                           Object obj = Object::createFromHostObject(rt, wrapper);
                                           obj.setExternalMemoryPressure(rt, 5 * 1024 * 1024);
                                           return obj;
@@ -241,29 +233,50 @@ void HermesEngine::installFunctions() {
 
     DEFINE_GLOBAL_FUNCTION("useState", 1,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::UseState);
                            return useStateImpl(args[0]);
                            });
 
+    DEFINE_GLOBAL_FUNCTION("toRaw", 1,
+                           [](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::ToRaw);
+                           if (count == 0) return Value::undefined();
+                           if (const auto cell = StateCell::from(rt, args[0])) return Value(rt, cell->current());
+                           return Value(rt, args[0]);
+                           });
+
     DEFINE_GLOBAL_FUNCTION("effect", 0,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::Effect);
                            componentEffectImpl(Value(rt,args[0]),args[1]);
                            return Value::undefined();
                            });
 
-    DEFINE_GLOBAL_FUNCTION("beginComponentInit", 1,
+    DEFINE_GLOBAL_FUNCTION("beginComponentInit", 2,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::BeginComponent);
+                           double slots = 0;
+                           if (count > 1 && !args[1].isUndefined()) {
+                           slots = args[1].isNumber() ? args[1].asNumber() : -1;
+                           if (!(slots >= 0 && slots <= MAX_CHILD_SLOTS) || std::trunc(slots) != slots) {
+                           throw JSError(rt, "beginComponentInit expects the component's slot count as its second argument");
+                           }
+                           }
                            beginComponentImpl();
+                           if (slots > 0) contextStack.top()->reserveSlots(static_cast<size_t>(slots));
                            return Value::undefined();
                            });
 
     DEFINE_GLOBAL_FUNCTION("endComponent", 0,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::EndComponent);
                            endComponentImpl();
                            return Value::undefined();
                            });
 
     DEFINE_GLOBAL_FUNCTION("listConciliar", 0,
                            [this](Runtime &rt, const Value &thisVal, const Value *args, size_t count) -> Value {
+                           BridgeScope scope(BridgeCall::ListConciliar);
                            auto container=args[0].asObject(rt).asHostObject<WidgetHostWrapper>(rt);
                            auto arrayObject=Value(rt,args[1]);
                            auto function=Value(rt,args[2]);
@@ -272,41 +285,72 @@ void HermesEngine::installFunctions() {
                            });
 }
 
-void HermesEngine::execute(const std::shared_ptr<Buffer> buf) const {
-    runtime->evaluateJavaScript(buf, "f.js");
+void HermesEngine::execute(const Bundle &bundle) const {
+    runtime->evaluateJavaScript(bundle.buffer, bundle.sourceURL);
 }
 
 
 void HermesEngine::shutdown() {
     _started = false;
-    componentsToBeUpdated.clear();
-    rootWidget->resetPointer();
+    scheduler.clear();
+    if (auto root = this->root()) reclaim.unmount(*root);
+    rootWidget = {};
+    reclaim.drainAll();
 }
 
-std::unique_ptr<WidgetHolder> HermesEngine::getWidgetHolder(StateWrapperRef &widgetVariable) {
-    const auto val = widgetVariable->getValue();
+std::unique_ptr<WidgetHolder> HermesEngine::getWidgetHolder(StateWrapper &widgetVariable) {
+    const auto val = widgetVariable.getValue();
     return getWidgetHolder(val);
 }
 
 std::unique_ptr<WidgetHolder> HermesEngine::getWidgetHolder(const Value &value) {
     auto &rt = *runtime;
 
-    return HermesWidgetHolder::create(rt, value);
+    return HermesWidgetHolder::create(rt, *names, value);
 }
 
-inline void HermesEngine::compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) {
-    auto &rt = *runtime;
+PropDiff HermesEngine::compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) {
+    TRACE_SCOPE(Props, "compareProps");
     const auto &oldHermesProps = dynamic_cast<HermesPropMap *>(old.get())->getHermesValue();
     const auto &newHermesProps = dynamic_cast<HermesPropMap *>(newMap.get())->getHermesValue();
-    //NOte: the returned value is an object contains all changed. We may print it.
-    rt.global().getProperty(rt, "diffAndUpdate").asObject(rt).asFunction(rt).call(rt, oldHermesProps, newHermesProps);
+    return HermesPropDiffer(*runtime, *names).diff(oldHermesProps, newHermesProps);
+}
+
+GcStats HermesEngine::gcStats() {
+    auto &rt = *runtime;
+    if (!instrumentedStatsResolved) {
+        instrumentedStatsResolved = true;
+        const auto internal = rt.global().getProperty(rt, "HermesInternal");
+        if (internal.isObject()) {
+            const auto function = internal.getObject(rt).getProperty(rt, "getInstrumentedStats");
+            if (function.isObject() && function.getObject(rt).isFunction(rt)) {
+                instrumentedStats = function.getObject(rt).getFunction(rt);
+            }
+        }
+    }
+    if (!instrumentedStats) return {};
+
+    const auto stats = instrumentedStats->call(rt).getObject(rt);
+    GcStats result;
+    const auto collections = stats.getProperty(rt, "js_numGCs");
+    if (collections.isNumber()) result.collections = static_cast<uint64_t>(collections.getNumber());
+    // Seconds.
+    const auto gcTime = stats.getProperty(rt, "js_gcTime");
+    if (gcTime.isNumber()) result.pauseMs = gcTime.getNumber() * 1000.0;
+    return result;
 }
 
 HermesEngine::~HermesEngine() {
     while (!contextStack.empty()) contextStack.pop();
-    pool.finished = true;
-    rootWidget.reset();
-    nextIterationComponents.clear();
-    componentsToBeUpdated.clear();
+    pool.finish();
+    mountedComponents.clear();
+    rootWidget = {};
+    reclaim.clear();
+    scheduler.clear();
+    // Interned names and shared host functions are runtime handles and have to go first.
+    hostMethods.reset();
+    cellMethods.reset();
+    instrumentedStats.reset();
+    names.reset();
     runtime.reset();
 }
@@ -8,11 +8,15 @@
 
 #include <complex.h>
 #include <memory>
+#include <optional>
 
 #include <hermes/hermes.h>
 #include <jsi/jsi.h>
 
+#include "BundleLoader.h"
 #include "HermesPropMap.h"
+#include "PropNameCache.h"
+#include "StateCell.h"
 #include "WidgetHostWrapper.h"
 #include "../../ui/ComponentContext.h"
 #include "../IEngine.h"
@@ -24,16 +28,17 @@ using namespace facebook::jsi;
 
 class HermesEngine : public IEngine {
 public:
-    explicit HermesEngine(std::unique_ptr<Runtime> runtime): runtime(std::move(runtime)) {
+    explicit HermesEngine(std::unique_ptr<Runtime> runtime): runtime(std::move(runtime)),
+                                                              names(std::make_unique<PropNameCache>(*this->runtime)) {
     }
 
     ~HermesEngine() override;
 
-    std::shared_ptr<Widget> createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) override;
+    Widget *createComponent(std::string &type, std::unique_ptr<PropMap> propsMap) override;
 
     void installFunctions() override;
 
-    void execute(std::shared_ptr<Buffer> buf) const;
+    void execute(const Bundle &bundle) const;
 
     void componentEffectImpl(Value fn, const Value &deps);
 
@@ -54,22 +59,56 @@ private:
 
     void render(const Value &value);
 
+    // render() has no host loop to hand frames to, so it drains the scheduler itself up to this many frames.
+    static constexpr size_t MAX_RENDER_FRAMES = 600;
+
 public:
-    SharedWidget findSharedWidget(StateWrapperRef &widgetVariable) override;
+    Widget *findWidget(StateWrapper &widgetVariable) override;
 
     void shutdown() override;
 
-    std::unique_ptr<WidgetHolder> getWidgetHolder(StateWrapperRef &widgetVariable) override;
+    std::unique_ptr<WidgetHolder> getWidgetHolder(StateWrapper &widgetVariable) override;
     std::unique_ptr<WidgetHolder> getWidgetHolder(const Value &value);
 
-    void compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) override;
+    PropDiff compareProps(const std::unique_ptr<PropMap> &old, const std::unique_ptr<PropMap> &newMap) override;
+
+    // From HermesInternal.getInstrumentedStats, which installEngine turns on with withShouldRecordStats.
+    GcStats gcStats() override;
+
+    const PropNameCache &propNames() const {
+        return *names;
+    }
+
+    const WidgetHostMethods &widgetMethods() const {
+        return *hostMethods;
+    }
+
+    Runtime &getRuntime() const {
+        return *runtime;
+    }
+
+    // Frames render() ticked and whether updates were still pending after MAX_RENDER_FRAMES of them. Hosts report it,
+    // the pending updates run on their next ticks.
+    size_t renderFrames() const {
+        return _renderFrames;
+    }
+
+    bool pendingAfterRender() const {
+        return _pendingAfterRender;
+    }
 
 private:
     bool _started = false;
+    size_t _renderFrames = 0;
+    bool _pendingAfterRender = false;
     std::unique_ptr<Runtime> runtime;
+    std::unique_ptr<PropNameCache> names;
+    std::unique_ptr<WidgetHostMethods> hostMethods;
+    std::unique_ptr<StateCellMethods> cellMethods;
+    // Looked up on the first gcStats call, empty if the runtime has no HermesInternal.
+    std::optional<Function> instrumentedStats;
+    bool instrumentedStatsResolved = false;
 
-    std::vector<std::shared_ptr<ComponentContext> > componentsToBeUpdated;
-    std::vector<std::shared_ptr<ComponentContext> > nextIterationComponents;
     std::shared_ptr<WidgetHostWrapper> randomWrapper;
 };
 
@@ -8,6 +8,6 @@ size_t HermesArray::size() {
     return arr.size(rt);
 }
 
-StateWrapperRef HermesArray::getValue(size_t index) {
+StateWrapper HermesArray::getValue(size_t index) {
     return StateWrapper::create(rt, arr.getValueAtIndex(rt, index));
 }
@@ -17,7 +17,7 @@ public:
 
     size_t size() override;
 
-    StateWrapperRef getValue(size_t index) override;
+    StateWrapper getValue(size_t index) override;
 
     ~HermesArray() override = default;
 
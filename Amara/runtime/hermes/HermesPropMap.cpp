@@ -6,12 +6,7 @@
 #define FALLBACK_IF(val) if (val.isUndefined()) return std::move(defaultValue);
 
 std::string HermesPropMap::getString(const std::string &key, const std::string &defaultValue) const {
-    auto val = get(key);
-    FALLBACK_IF(val)
-    if (val.isNumber()) {
-        return std::to_string(val.asNumber());
-    }
-    return val.asString(runtime).utf8(runtime);
+    return toString(get(key), defaultValue);
 }
 
 bool HermesPropMap::getBool(const std::string &key, bool defaultValue) const {
@@ -37,22 +32,12 @@ std::unique_ptr<void, void(*)(void *)> HermesPropMap::getFunction(const std::str
 }
 
 double HermesPropMap::getNumber(const std::string &key, double defaultValue) const {
-    // FALLBACK_IF;
-    auto value = get(key);
-    if (value.isString()) {
-        try {
-            return std::stoi(value.asString(runtime).utf8(runtime));
-        } catch (const std::invalid_argument &) {
-            //TODO
-            //logError("Failed to parse string as integer for prop: " + key);
-            return defaultValue;
-        }
-    }
-    return value.asNumber();
+    return toNumber(get(key), defaultValue);
 }
 
 bool HermesPropMap::has(const std::string &key) const {
     //ScopedTimer timer;
+    flush();
     return obj.hasProperty(runtime, key.c_str());
 }
 
@@ -61,21 +46,15 @@ void HermesPropMap::remove(const std::string &key) const {
 }
 
 std::unique_ptr<PropMap> HermesPropMap::getObject(const std::string &key) const {
-    auto value = get(key);
-    if (!value.isObject()) {
-        return nullptr;
-    }
-    return std::make_unique<HermesPropMap>(runtime, std::move(value));
+    return toObject(get(key));
 }
 
 std::unique_ptr<AmaraArray> HermesPropMap::getArray(const std::string &key) const {
-    auto value = get(key);
-    if (value.isUndefined()) return  nullptr;
-    auto arr = value.asObject(runtime).asArray(runtime);
-    return std::make_unique<HermesArray>(runtime, std::move(arr));
+    return toArray(get(key));
 }
 
 Value HermesPropMap::get(const std::string &key) const {
+    flush();
     return obj.getProperty(runtime, key.c_str());
 }
 
@@ -90,3 +69,116 @@ void HermesPropMap::set(const std::string &key, std::unique_ptr<PropMap> &map) c
 void HermesPropMap::set(const std::string &key, const std::string &value) const {
     obj.setProperty(runtime, key.c_str(), Value(String::createFromAscii(runtime, value.c_str())));
 }
+
+double HermesPropMap::getNumber(PropKey key, double defaultValue) const {
+    return toNumber(get(key), defaultValue);
+}
+
+std::string HermesPropMap::getString(PropKey key, const std::string &defaultValue) const {
+    return toString(get(key), defaultValue);
+}
+
+bool HermesPropMap::getBool(PropKey key, bool defaultValue) const {
+    auto value = get(key);
+    if (!value.isBool()) return defaultValue;
+    return value.getBool();
+}
+
+std::unique_ptr<PropMap> HermesPropMap::getObject(PropKey key) const {
+    return toObject(get(key));
+}
+
+std::unique_ptr<AmaraArray> HermesPropMap::getArray(PropKey key) const {
+    return toArray(get(key));
+}
+
+bool HermesPropMap::has(PropKey key) const {
+    flush();
+    return obj.hasProperty(runtime, names[key]);
+}
+
+Value HermesPropMap::get(PropKey key) const {
+    flush();
+    return obj.getProperty(runtime, names[key]);
+}
+
+void HermesPropMap::defer(const PropNameID &name, const Value &value) const {
+    for (auto &[key, pending]: deferred) {
+        if (PropNameID::compare(runtime, key, name)) {
+            pending = Value(runtime, value);
+            return;
+        }
+    }
+    deferred.emplace_back(PropNameID(runtime, name), Value(runtime, value));
+}
+
+void HermesPropMap::flush() const {
+    if (deferred.empty()) return;
+    // Moved out first, the deleteProperty call runs JS.
+    auto writes = std::move(deferred);
+    deferred.clear();
+    for (auto &[name, value]: writes) {
+        if (value.isUndefined() || value.isNull()) {
+            withUtf8(runtime, name, [&](std::string_view key) {
+                names.deleteProperty().call(runtime, obj, String::createFromUtf8(
+                                                runtime, reinterpret_cast<const uint8_t *>(key.data()), key.size()));
+            });
+        } else {
+            obj.setProperty(runtime, name, std::move(value));
+        }
+    }
+}
+
+void HermesPropMap::forEachEntry(const std::function<void(const Entry &entry)> &fn) const {
+    flush();
+    const auto keys = obj.getPropertyNames(runtime);
+    const size_t count = keys.size(runtime);
+    for (size_t i = 0; i < count; ++i) {
+        const auto name = keys.getValueAtIndex(runtime, i).getString(runtime);
+        const auto value = obj.getProperty(runtime, name);
+        if (!value.isString() && !value.isNumber()) continue;
+        withUtf8(runtime, name, [&](std::string_view key) {
+            if (value.isNumber()) {
+                fn(Entry{key, true, value.getNumber(), {}});
+                return;
+            }
+            withUtf8(runtime, value.getString(runtime), [&](std::string_view text) {
+                fn(Entry{key, false, 0, text});
+            });
+        });
+    }
+}
+
+double HermesPropMap::toNumber(const Value &value, double defaultValue) const {
+    if (value.isString()) {
+        try {
+            return std::stoi(value.asString(runtime).utf8(runtime));
+        } catch (const std::invalid_argument &) {
+            //TODO
+            //logError("Failed to parse string as integer for prop: " + key);
+            return defaultValue;
+        }
+    }
+    return value.asNumber();
+}
+
+std::string HermesPropMap::toString(const Value &value, const std::string &defaultValue) const {
+    FALLBACK_IF(value)
+    if (value.isNumber()) {
+        return std::to_string(value.asNumber());
+    }
+    return value.asString(runtime).utf8(runtime);
+}
+
+std::unique_ptr<PropMap> HermesPropMap::toObject(Value value) const {
+    if (!value.isObject()) {
+        return nullptr;
+    }
+    return std::make_unique<HermesPropMap>(runtime, names, std::move(value));
+}
+
+std::unique_ptr<AmaraArray> HermesPropMap::toArray(const Value &value) const {
+    if (value.isUndefined()) return nullptr;
+    auto arr = value.asObject(runtime).asArray(runtime);
+    return std::make_unique<HermesArray>(runtime, std::move(arr));
+}
@@ -7,12 +7,15 @@
 #include "../PropMap.h"
 #include <jsi/jsi.h>
 #include "Invoker.h"
+#include "PropNameCache.h"
 #include <utility>
+#include <vector>
 using namespace facebook::jsi;
 
 class HermesPropMap : public PropMap {
 public:
-    HermesPropMap(Runtime &runtime, Value value): obj(value.asObject(runtime)), runtime(runtime) {
+    HermesPropMap(Runtime &runtime, const PropNameCache &names, Value value): obj(value.asObject(runtime)),
+                                                                             runtime(runtime), names(names) {
     }
 
 
@@ -35,19 +38,59 @@ public:
 
     Value get(const std::string &key) const;
 
-    void set(const std::string &key, double value) const;
+    void set(const std::string &key, double value) const override;
 
-    void set(const std::string &key, std::unique_ptr<PropMap> &map) const;
+    void set(const std::string &key, std::unique_ptr<PropMap> &map) const override;
 
-    void set(const std::string &key, const std::string &value) const;
+    void set(const std::string &key, const std::string &value) const override;
+
+    double getNumber(PropKey key, double defaultValue) const override;
+
+    [[nodiscard]] std::string getString(PropKey key, const std::string &defaultValue) const override;
+
+    bool getBool(PropKey key, bool defaultValue) const override;
+
+    std::unique_ptr<PropMap> getObject(PropKey key) const override;
+
+    std::unique_ptr<AmaraArray> getArray(PropKey key) const override;
+
+    bool has(PropKey key) const override;
+
+    Value get(PropKey key) const;
+
+    void forEachEntry(const std::function<void(const Entry &entry)> &fn) const override;
 
     const Object &getHermesValue() const {
+        flush();
         return obj;
     }
 
+    /**
+     * Queues a write to the JS object instead of doing it now, for values native code already applied (style
+     * writes from JS). A later write to the same key replaces the queued one, undefined and null delete the key.
+     * Flushed before the object is read through this map.
+     */
+    void defer(const PropNameID &name, const Value &value) const;
+
+    void flush() const override;
+
+    const PropNameCache &propNames() const {
+        return names;
+    }
+
 private:
+    double toNumber(const Value &value, double defaultValue) const;
+
+    std::string toString(const Value &value, const std::string &defaultValue) const;
+
+    std::unique_ptr<PropMap> toObject(Value value) const;
+
+    std::unique_ptr<AmaraArray> toArray(const Value &value) const;
+
     Object obj;
     Runtime &runtime;
+    const PropNameCache &names;
+    mutable std::vector<std::pair<PropNameID, Value> > deferred;
 };
 
 
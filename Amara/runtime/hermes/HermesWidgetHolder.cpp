@@ -6,27 +6,30 @@
 #include "../../ui/Widget.h"
 #include "WidgetHostWrapper.h"
 #include "Engine.h"
+#include "../../utils/BridgeStats.h"
+#include "../../utils/Trace.h"
 
-std::shared_ptr<Widget> HermesWidgetHolder::execute(IEngine *engine) {
+Widget *HermesWidgetHolder::execute(IEngine *engine) {
     auto hermesProps = dynamic_cast<HermesPropMap *>(_props.get());
     if (isInternal) {
         assert(componentName.has_value() && "Component marked as internal but without component Name");
 
-        auto arr = hermesProps->get("children").asObject(rt).asArray(rt);
+        auto arr = hermesProps->get(PropKey::Children).asObject(rt).asArray(rt);
         auto &c = hermesProps->getHermesValue();
-        auto widget = engine->createComponent(componentName.value(), std::make_unique<HermesPropMap>(rt, Value(rt, c)));
+        auto widget = engine->createComponent(componentName.value(),
+                                              std::make_unique<HermesPropMap>(rt, names, Value(rt, c)));
         if (widget->is<TextWidget>()) {
             auto textWidget = widget->as<TextWidget>();
             for (int i = 0; i < arr.size(rt); ++i) {
                 auto val = arr.getValueAtIndex(rt, i);
                 std::string string;
                 if (val.isObject()) {
-                    auto wrapper = StateWrapper::create(rt, std::move(val));
-                    if (wrapper->isStateVariable()) {
-                        string = wrapper->getInternalValue()->getValue().asString(rt).utf8(rt);
+                    if (const auto cell = StateCell::from(rt, val)) {
+                        string = cell->current().asString(rt).utf8(rt);
                     } else {
-                        string = val.asObject(rt).getProperty(rt, "toString").asObject(rt).asFunction(rt).call(rt).
-                                asString(rt).utf8(rt);
+                        BridgeScope scope(BridgeCall::CallToString);
+                        string = val.asObject(rt).getProperty(rt, names[PropKey::ToString]).asObject(rt).asFunction(rt).
+                                call(rt).asString(rt).utf8(rt);
                     }
                 } else {
                     string = val.asString(rt).utf8(rt);
@@ -39,8 +42,7 @@ std::shared_ptr<Widget> HermesWidgetHolder::execute(IEngine *engine) {
                 auto val = arr.getValueAtIndex(rt, i);
                 auto ref = StateWrapper::create(rt, std::move(val));
                 auto child = engine->getWidgetHolder(ref);
-                auto childWidget = child->execute(engine);
-                container->addChild(childWidget);
+                container->addChild(*child->execute(engine));
             }
         }
         if (key().hasKey()) {
@@ -49,41 +51,44 @@ std::shared_ptr<Widget> HermesWidgetHolder::execute(IEngine *engine) {
         return widget;
     }
     auto &c = hermesProps->getHermesValue();
+    BridgeScope scope(BridgeCall::CallComponent);
+    TRACE_SCOPE(Js, "component");
     const auto result = componentFunction->asObject(rt).asFunction(rt).call(rt, Value(rt, c));
     auto widget = result.asObject(rt).asHostObject<WidgetHostWrapper>(rt)->getNativeWidget();
     if (key().hasKey()) {
         widget->key = key();
     }
     widget->component()->componentObject = StateWrapper::create(rt, Value(rt, *componentFunction));
+    widget->component()->setRootWidget(widget->handle());
     return widget;
 }
 
 std::vector<std::unique_ptr<WidgetHolder> > HermesWidgetHolder::getChildren() {
-    auto arr = _props->getArray("children");
+    auto arr = _props->getArray(PropKey::Children);
     if (!arr) return {};
     std::vector<std::unique_ptr<WidgetHolder> > children;
     children.reserve(arr->size());
     for (int i = 0; i < arr->size(); ++i) {
         const auto val = arr->getValue(i);
-        children.emplace_back(create(rt, val->getValueRef()));
+        children.emplace_back(create(rt, names, val.getValueRef()));
     }
 
     return children;
 }
 
 std::vector<std::string> HermesWidgetHolder::getTextChildren() {
-    auto arr = _props->getArray("children");
+    auto arr = _props->getArray(PropKey::Children);
     if (!arr) return {};
     std::vector<std::string> text;
     text.reserve(arr->size());
     for (int i = 0; i < arr->size(); ++i) {
         const auto val = arr->getValue(i);
-        text.push_back(val->getValueRef().asString(rt).utf8(rt));
+        text.push_back(val.getValueRef().asString(rt).utf8(rt));
     }
     return text;
 }
 
-bool HermesWidgetHolder::sameComponent(StateWrapperRef &other) {
+bool HermesWidgetHolder::sameComponent(StateWrapper &other) {
     if (!other) return false;
-    return other->equals(*componentFunction);
+    return other.equals(*componentFunction);
 }
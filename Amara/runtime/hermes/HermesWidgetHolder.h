@@ -5,6 +5,7 @@
 #ifndef HERMESWIDGETOLDER_H
 #define HERMESWIDGETOLDER_H
 
+#include <cmath>
 #include <memory>
 
 #include "HermesPropMap.h"
@@ -19,62 +20,67 @@ class HermesWidgetHolder : public WidgetHolder {
 public:
     ~HermesWidgetHolder() override = default;
 
-    HermesWidgetHolder(Runtime &rt, std::unique_ptr<Value> componentFunction, std::unique_ptr<HermesPropMap> props,
-                       const Key &key = Key())
+    HermesWidgetHolder(Runtime &rt, const PropNameCache &names, std::unique_ptr<Value> componentFunction,
+                       std::unique_ptr<HermesPropMap> props, const Key &key = Key())
         : WidgetHolder(key, std::move(props)), componentFunction(std::move(componentFunction)),
-          rt(rt) {
+          rt(rt), names(names) {
     }
 
-    HermesWidgetHolder(Runtime &rt, std::string componentName, std::unique_ptr<HermesPropMap> props,
-                       std::optional<std::string> id = std::nullopt,
-                       Key key = Key()) : WidgetHolder(std::move(componentName), std::move(props), std::move(id), key),
-                                          rt(rt) {
+    HermesWidgetHolder(Runtime &rt, const PropNameCache &names, std::string componentName,
+                       std::unique_ptr<HermesPropMap> props, ChildSlot slot = NO_CHILD_SLOT,
+                       Key key = Key()) : WidgetHolder(std::move(componentName), std::move(props), slot, key),
+                                          rt(rt), names(names) {
     }
 
-    std::shared_ptr<Widget> execute(IEngine *engine) override;
+    Widget *execute(IEngine *engine) override;
 
     std::vector<std::unique_ptr<WidgetHolder> > getChildren() override;
 
     std::vector<std::string> getTextChildren() override;
 
-    static std::unique_ptr<HermesWidgetHolder> create(Runtime &rt, const Value &value) {
+    static std::unique_ptr<HermesWidgetHolder> create(Runtime &rt, const PropNameCache &names, const Value &value) {
         Object obj = value.asObject(rt);
-        const auto isInternal = obj.getProperty(rt, "$$internalComponent").asBool();
+        const auto isInternal = obj.getProperty(rt, names[PropKey::InternalComponent]).asBool();
         std::unique_ptr<HermesWidgetHolder> holder;
-        auto props = obj.getProperty(rt, "props");
+        auto props = obj.getProperty(rt, names[PropKey::Props]);
         Key key;
-        if (obj.hasProperty(rt, "key")) {
-            auto keyValue = obj.getProperty(rt, "key");
-            if (keyValue.isString()) {
-                key = std::move(keyValue.asString(rt).utf8(rt));
-            } else if (keyValue.isNumber()) {
-                key = std::to_string(static_cast<int>(keyValue.asNumber()));
-            }
+        auto keyValue = obj.getProperty(rt, names[PropKey::Key]);
+        if (keyValue.isString()) {
+            key = std::move(keyValue.asString(rt).utf8(rt));
+        } else if (keyValue.isNumber()) {
+            key = std::to_string(static_cast<int>(keyValue.asNumber()));
         }
-        auto propMap = std::make_unique<HermesPropMap>(rt, std::move(props));
+        auto propMap = std::make_unique<HermesPropMap>(rt, names, std::move(props));
         if (isInternal) {
-            auto componentName = obj.getProperty(rt, "component").asString(rt).utf8(rt);
-
-            std::optional<std::string> id;
-            if (obj.hasProperty(rt, "id")) {
-                id = obj.getProperty(rt, "id").asString(rt).utf8(rt);
+            auto componentName = obj.getProperty(rt, names[PropKey::Component]).asString(rt).utf8(rt);
+
+            ChildSlot slot = NO_CHILD_SLOT;
+            auto slotValue = obj.getProperty(rt, names[PropKey::Slot]);
+            if (slotValue.isNumber()) {
+                // Checked against the component's slot count when the child is added.
+                const double number = slotValue.asNumber();
+                if (!(number >= 0 && number < MAX_CHILD_SLOTS) || std::trunc(number) != number) {
+                    throw JSError(rt, "A static child's slot must be an integer slot number");
+                }
+                slot = static_cast<ChildSlot>(number);
             }
-            holder = std::make_unique<HermesWidgetHolder>(rt, componentName, std::move(propMap), id,
+            holder = std::make_unique<HermesWidgetHolder>(rt, names, componentName, std::move(propMap), slot,
                                                           std::move(key));
         } else {
-            auto func = obj.getProperty(rt, "component");
+            auto func = obj.getProperty(rt, names[PropKey::Component]);
 
-            holder = std::make_unique<HermesWidgetHolder>(rt, std::make_unique<Value>(rt, func), std::move(propMap),
-                                                          std::move(key));
+            holder = std::make_unique<HermesWidgetHolder>(rt, names, std::make_unique<Value>(rt, func),
+                                                          std::move(propMap), std::move(key));
         }
         return holder;
     }
 
-    bool sameComponent(StateWrapperRef &other) override;
+    bool sameComponent(StateWrapper &other) override;
 
 private:
     std::unique_ptr<Value> componentFunction;
     Runtime &rt;
+    const PropNameCache &names;
 };
 
 
@@ -1,5 +1,9 @@
 #include "InstallEngine.h"
 
+#include <cstdlib>
+
+#include "../../utils/BridgeStats.h"
+
 using namespace hermes;
 
 std::unique_ptr<HermesEngine> installEngine() {
@@ -26,8 +30,14 @@ std::unique_ptr<HermesEngine> installEngine() {
         .build();
 
 
+    // Bridge counters can also be switched at any point through BridgeStats::setEnabled.
+    if (const char *bridgeStats = std::getenv("AMARA_BRIDGE_STATS")) {
+        BridgeStats::setEnabled(bridgeStats[0] == '1');
+    }
+
     auto runtime = makeHermesRuntime(runtimeConfig);
     auto engine = std::make_unique<HermesEngine>(std::move(runtime));
     engine->installFunctions();
+    engine->execute(BundleLoader::prelude());
     return engine;
 }
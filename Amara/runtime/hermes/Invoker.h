@@ -11,7 +11,7 @@ public:
                                                                    func(value->asObject(runtime).asFunction(runtime)) {
     }
 
-    void invoke(std::initializer_list<StateWrapperRef> wrapper) override {
+    void invoke(std::initializer_list<StateWrapper> wrapper) override {
     }
 
     Runtime &runtime;
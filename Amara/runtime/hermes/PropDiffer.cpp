@@ -0,0 +1,119 @@
+#include "PropDiffer.h"
+
+static void addChange(PropDiff &result, const std::string &path, std::string key, PropChangeKind kind) {
+    result.changes.push_back({path.empty() ? std::move(key) : path + key, kind});
+}
+
+PropDiff HermesPropDiffer::diff(const Object &oldProps, const Object &newProps) {
+    PropDiff result;
+    std::string path;
+    diffObjects(oldProps, newProps, path, result);
+    return result;
+}
+
+bool HermesPropDiffer::isEventHandler(const PropNameID &name, const Value &value) {
+    if (!value.isObject() || !value.getObject(runtime).isFunction(runtime)) return false;
+    const auto key = name.utf8(runtime);
+    return key.size() > 2 && key[0] == 'o' && key[1] == 'n';
+}
+
+void HermesPropDiffer::diffObjects(const Object &oldObject, const Object &newObject, std::string &path,
+                                   PropDiff &result) {
+    auto &rt = runtime;
+    const auto &children = names[PropKey::Children];
+    // Taken before adding new keys, so the second loop only visits keys that existed before.
+    const auto oldKeys = oldObject.getPropertyNames(rt);
+    const auto newKeys = newObject.getPropertyNames(rt);
+
+    const size_t newCount = newKeys.size(rt);
+    for (size_t i = 0; i < newCount; ++i) {
+        const auto name = PropNameID::forString(rt, newKeys.getValueAtIndex(rt, i).getString(rt));
+        if (PropNameID::compare(rt, name, children)) continue;
+        if (!oldObject.getProperty(rt, name).isUndefined()) continue;
+
+        auto value = newObject.getProperty(rt, name);
+        //events will always be different, so we don't need to check on it.
+        if (value.isUndefined() || isEventHandler(name, value)) continue;
+        oldObject.setProperty(rt, name, std::move(value));
+        addChange(result, path, name.utf8(rt), PropChangeKind::Added);
+    }
+
+    const size_t oldCount = oldKeys.size(rt);
+    for (size_t i = 0; i < oldCount; ++i) {
+        const auto name = PropNameID::forString(rt, oldKeys.getValueAtIndex(rt, i).getString(rt));
+        if (PropNameID::compare(rt, name, children)) continue;
+
+        const auto oldValue = oldObject.getProperty(rt, name);
+        // Removed by a previous diff, jsi cannot delete properties so they are left as undefined.
+        if (oldValue.isUndefined()) continue;
+
+        auto newValue = newObject.getProperty(rt, name);
+        if (newValue.isUndefined()) {
+            oldObject.setProperty(rt, name, Value::undefined());
+            addChange(result, path, name.utf8(rt), PropChangeKind::Removed);
+            continue;
+        }
+        if (isEqual(oldValue, newValue)) continue;
+
+        if (isPlainObject(oldValue) && isPlainObject(newValue)) {
+            const auto length = path.size();
+            path.append(name.utf8(rt)).push_back('.');
+            diffObjects(oldValue.getObject(rt), newValue.getObject(rt), path, result);
+            path.resize(length);
+        } else {
+            oldObject.setProperty(rt, name, std::move(newValue));
+            addChange(result, path, name.utf8(rt), PropChangeKind::Changed);
+        }
+    }
+}
+
+bool HermesPropDiffer::isEqual(const Value &first, const Value &second) {
+    auto &rt = runtime;
+    if (Value::strictEquals(rt, first, second)) return true;
+    if (!first.isObject() || !second.isObject()) return false;
+
+    const auto a = first.getObject(rt);
+    const auto b = second.getObject(rt);
+    // Functions are only equal by identity which was checked above.
+    if (a.isFunction(rt) || b.isFunction(rt)) return false;
+
+    if (a.isArray(rt) || b.isArray(rt)) {
+        if (!a.isArray(rt) || !b.isArray(rt)) return false;
+        const auto first = a.getArray(rt);
+        const auto second = b.getArray(rt);
+        const size_t size = first.size(rt);
+        if (size != second.size(rt)) return false;
+        for (size_t i = 0; i < size; ++i) {
+            if (!isEqual(first.getValueAtIndex(rt, i), second.getValueAtIndex(rt, i))) return false;
+        }
+        return true;
+    }
+
+    // Keys holding undefined are absent, so a key removed by an earlier diff doesn't make the objects differ.
+    const auto aKeys = a.getPropertyNames(rt);
+    const size_t aCount = aKeys.size(rt);
+    size_t defined = 0;
+    for (size_t i = 0; i < aCount; ++i) {
+        const auto name = PropNameID::forString(rt, aKeys.getValueAtIndex(rt, i).getString(rt));
+        auto value = a.getProperty(rt, name);
+        if (value.isUndefined()) continue;
+        ++defined;
+        if (!isEqual(value, b.getProperty(rt, name))) return false;
+    }
+    const auto bKeys = b.getPropertyNames(rt);
+    const size_t bCount = bKeys.size(rt);
+    // Every defined key of `a` matched a defined key of `b`, so `b` has no more defined keys than `a` had.
+    if (bCount == defined) return true;
+    for (size_t i = 0; i < bCount; ++i) {
+        if (!b.getProperty(rt, PropNameID::forString(rt, bKeys.getValueAtIndex(rt, i).getString(rt))).isUndefined()) {
+            if (defined-- == 0) return false;
+        }
+    }
+    return true;
+}
+
+bool HermesPropDiffer::isPlainObject(const Value &value) {
+    if (!value.isObject()) return false;
+    const auto object = value.getObject(runtime);
+    return !object.isArray(runtime) && !object.isFunction(runtime);
+}
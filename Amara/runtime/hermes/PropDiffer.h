@@ -0,0 +1,40 @@
+#ifndef PROPDIFFER_H
+#define PROPDIFFER_H
+
+#include <string>
+
+#include <jsi/jsi.h>
+#include "../PropDiff.h"
+#include "PropNameCache.h"
+using namespace facebook::jsi;
+
+/**
+ * Native replacement for the diffAndUpdate JS helper. Walks both prop objects through JSI, copies every change into
+ * the old object (so the widget's props stay current) and reports the changed keys.
+ *
+ * Keys are compared as PropNameIDs against the engine's PropNameCache, a key is only converted to UTF-8 when it is
+ * reported or its value is a function (to tell event handlers apart). A key holding undefined counts as absent, that
+ * is how removed keys are left since jsi cannot delete properties.
+ */
+class HermesPropDiffer {
+public:
+    HermesPropDiffer(Runtime &runtime, const PropNameCache &names) : runtime(runtime), names(names) {
+    }
+
+    PropDiff diff(const Object &oldProps, const Object &newProps);
+
+private:
+    void diffObjects(const Object &oldObject, const Object &newObject, std::string &path, PropDiff &result);
+
+    bool isEqual(const Value &first, const Value &second);
+
+    bool isPlainObject(const Value &value);
+
+    // True for `on*` keys holding a function, they aren't copied over when added.
+    bool isEventHandler(const PropNameID &name, const Value &value);
+
+    Runtime &runtime;
+    const PropNameCache &names;
+};
+
+#endif //PROPDIFFER_H
@@ -0,0 +1,110 @@
+#ifndef PROPNAMECACHE_H
+#define PROPNAMECACHE_H
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <jsi/jsi.h>
+#include "../PropKey.h"
+#include "../../utils/css/StyleProperty.h"
+using namespace facebook::jsi;
+
+// Longest text withUtf8 reads onto the stack, every name the engine dispatches on and most style values are shorter.
+constexpr size_t MAX_INLINE_TEXT = 64;
+
+#if JSI_VERSION >= 14
+// Collects the chunks JSI hands out, `fits` is false once the text isn't short ASCII.
+struct InlineText {
+    char data[MAX_INLINE_TEXT];
+    size_t length = 0;
+    bool fits = true;
+
+    void operator()(bool ascii, const void *chunk, size_t count) {
+        if (!ascii || !fits || length + count > MAX_INLINE_TEXT) {
+            fits = false;
+            return;
+        }
+        std::memcpy(data + length, chunk, count);
+        length += count;
+    }
+};
+#endif
+
+/**
+ * Calls `fn` with the UTF-8 text of a name as a string_view. Where JSI exposes the runtime's own string data, short
+ * ASCII text is copied to the stack so dispatching on a name or parsing a value doesn't allocate, anything else goes
+ * through utf8().
+ */
+template<typename Fn>
+void withUtf8(Runtime &rt, const PropNameID &name, Fn &&fn) {
+#if JSI_VERSION >= 14
+    InlineText text;
+    name.getPropNameIdData(rt, text);
+    if (text.fits) {
+        fn(std::string_view(text.data, text.length));
+        return;
+    }
+#endif
+    const auto utf8 = name.utf8(rt);
+    fn(std::string_view(utf8));
+}
+
+template<typename Fn>
+void withUtf8(Runtime &rt, const String &string, Fn &&fn) {
+#if JSI_VERSION >= 14
+    InlineText text;
+    string.getStringData(rt, text);
+    if (text.fits) {
+        fn(std::string_view(text.data, text.length));
+        return;
+    }
+#endif
+    const auto utf8 = string.utf8(rt);
+    fn(std::string_view(utf8));
+}
+
+/**
+ * Atom table of the property names the engine reads. PropNameIDs are created once per runtime so descriptor and
+ * style lookups skip the C string -> PropNameID conversion hermes does on every getProperty(rt, "name"). Style names
+ * are looked up by their text through the perfect hash in StyleProperty.h.
+ *
+ * Owned by the engine, must be destroyed before the runtime.
+ */
+class PropNameCache {
+public:
+    // jsi has no delete, Reflect.deleteProperty is the same operation as the `delete` operator.
+    explicit PropNameCache(Runtime &rt) : _deleteProperty(
+        rt.global().getPropertyAsObject(rt, "Reflect").getPropertyAsFunction(rt, "deleteProperty")) {
+        names.reserve(PROP_KEY_COUNT);
+        for (size_t i = 0; i < PROP_KEY_COUNT; ++i) {
+            names.emplace_back(PropNameID::forAscii(rt, propKeyName(static_cast<PropKey>(i))));
+        }
+    }
+
+    PropNameCache(const PropNameCache &) = delete;
+
+    const PropNameID &operator[](PropKey key) const {
+        return names[static_cast<size_t>(key)];
+    }
+
+    // Reflect.deleteProperty, fetched once.
+    const Function &deleteProperty() const {
+        return _deleteProperty;
+    }
+
+    // lookupStyleProperty for a name JS already interned, returns false if it isn't a style property.
+    static bool styleProperty(Runtime &rt, const PropNameID &name, StyleProperty &property) {
+        bool found = false;
+        withUtf8(rt, name, [&](std::string_view text) {
+            found = lookupStyleProperty(text, property);
+        });
+        return found;
+    }
+
+private:
+    std::vector<PropNameID> names;
+    Function _deleteProperty;
+};
+
+#endif //PROPNAMECACHE_H
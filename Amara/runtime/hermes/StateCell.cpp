@@ -0,0 +1,76 @@
+#include "StateCell.h"
+
+#include "../../utils/BridgeStats.h"
+
+StateCellMethods::StateCellMethods(Runtime &rt, const PropNameCache &names)
+    : names(names),
+      setValue(Function::createFromHostFunction(
+          rt, names[PropKey::SetValue], 1,
+          [](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) -> Value {
+              BridgeScope scope(BridgeCall::CellSetValue);
+              const auto cell = StateCell::from(rt, thisValue);
+              if (!cell) {
+                  throw JSError(rt, "setValue must be called on a state variable");
+              }
+              if (count == 0) {
+                  cell->store(rt, Value::undefined());
+              } else {
+                  cell->store(rt, args[0]);
+              }
+              return Value::undefined();
+          })),
+      box(rt.global().getPropertyAsFunction(rt, "Object")) {
+}
+
+Value StateCell::get(Runtime &rt, const PropNameID &name) {
+    BridgeScope scope(BridgeCall::CellGet);
+    const auto &names = methods.names;
+    if (PropNameID::compare(rt, name, names[PropKey::Value])) {
+        return Value(rt, value);
+    }
+    if (PropNameID::compare(rt, name, names[PropKey::SetValue])) {
+        return Value(rt, methods.setValue);
+    }
+    // Kept for bundles that still probe cells from JS.
+    if (PropNameID::compare(rt, name, names[PropKey::IsStateVariable])) {
+        return Value(true);
+    }
+
+    if (value.isUndefined() || value.isNull()) return Value::undefined();
+    if (!value.isObject() && !boxed) {
+        boxed = methods.box.call(rt, value).getObject(rt);
+    }
+    auto property = value.isObject() ? value.getObject(rt).getProperty(rt, name) : boxed->getProperty(rt, name);
+    // Methods are bound to the value, `cell.trim()` would otherwise run with the cell as `this`.
+    if (!property.isObject()) return property;
+    auto object = property.getObject(rt);
+    if (!object.isFunction(rt)) return property;
+    for (const auto &method: boundMethods) {
+        if (PropNameID::compare(rt, method.name, name) && Object::strictEquals(rt, method.method, object)) {
+            return Value(rt, method.bound);
+        }
+    }
+    const auto bind = object.getProperty(rt, names[PropKey::Bind]).getObject(rt).getFunction(rt);
+    auto bound = bind.callWithThis(rt, object, value);
+    boundMethods.push_back(BoundMethod{PropNameID(rt, name), std::move(object), bound.getObject(rt)});
+    return bound;
+}
+
+void StateCell::set(Runtime &rt, const PropNameID &name, const Value &newValue) {
+    if (!value.isObject()) {
+        throw JSError(rt, "Cannot set property " + name.utf8(rt) + " on a primitive state value");
+    }
+    value.getObject(rt).setProperty(rt, name, newValue);
+}
+
+std::vector<PropNameID> StateCell::getPropertyNames(Runtime &rt) {
+    std::vector<PropNameID> names;
+    if (!value.isObject()) return names;
+    const auto keys = value.getObject(rt).getPropertyNames(rt);
+    const size_t count = keys.size(rt);
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        names.emplace_back(PropNameID::forString(rt, keys.getValueAtIndex(rt, i).getString(rt)));
+    }
+    return names;
+}
@@ -0,0 +1,84 @@
+#ifndef STATECELL_H
+#define STATECELL_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <jsi/jsi.h>
+#include "PropNameCache.h"
+using namespace facebook::jsi;
+
+/**
+ * Runtime handles every state cell shares. Owned by the engine and, like the other runtime handles, destroyed before
+ * the runtime.
+ */
+class StateCellMethods {
+public:
+    StateCellMethods(Runtime &rt, const PropNameCache &names);
+
+    const PropNameCache &names;
+    // `cell.setValue(v)`, resolves the cell from `this`.
+    Function setValue;
+    // The global `Object`, boxes primitives so `cell.length` or `cell.trim()` reach String/Number members.
+    Function box;
+};
+
+/**
+ * The value `useState` hands to components. Replaces the Proxy createRef used to build: the value lives in the cell,
+ * `cell.value` and native reads go straight to it and any other property is forwarded to the value itself, so
+ * component code can keep using a state variable as if it were the value.
+ *
+ * The engine recognises cells by their host object type, see StateCell::from.
+ */
+class StateCell : public HostObject {
+public:
+    StateCell(const StateCellMethods &methods, Value value) : methods(methods), value(std::move(value)) {
+    }
+
+    // The cell behind `value`, or null if it isn't one.
+    static std::shared_ptr<StateCell> from(Runtime &rt, const Value &value) {
+        if (!value.isObject()) return nullptr;
+        const auto object = value.getObject(rt);
+        if (!object.isHostObject<StateCell>(rt)) return nullptr;
+        return object.getHostObject<StateCell>(rt);
+    }
+
+    static bool is(Runtime &rt, const Value &value) {
+        return value.isObject() && value.getObject(rt).isHostObject<StateCell>(rt);
+    }
+
+    const Value &current() const {
+        return value;
+    }
+
+    void store(Runtime &rt, const Value &newValue) {
+        value = Value(rt, newValue);
+        // Bound to the previous value.
+        boxed.reset();
+        boundMethods.clear();
+    }
+
+    Value get(Runtime &rt, const PropNameID &name) override;
+
+    void set(Runtime &rt, const PropNameID &name, const Value &newValue) override;
+
+    std::vector<PropNameID> getPropertyNames(Runtime &rt) override;
+
+private:
+    struct BoundMethod {
+        PropNameID name;
+        // The method as read from the value, a reassigned method is bound again.
+        Object method;
+        Object bound;
+    };
+
+    const StateCellMethods &methods;
+    Value value;
+    // The value boxed by `Object(value)` for primitives, created on the first member read.
+    std::optional<Object> boxed;
+    // Methods read through the cell, bound to the value once instead of on every read.
+    std::vector<BoundMethod> boundMethods;
+};
+
+#endif //STATECELL_H
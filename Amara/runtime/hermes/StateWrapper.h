@@ -1,73 +1,102 @@
 #ifndef STATEWRAPPER_H
 #define STATEWRAPPER_H
+#include <cstddef>
+
 #include <hermes/hermes.h>
+#include "StateCell.h"
 using namespace facebook::jsi;
 
-class StateWrapper;
-typedef std::unique_ptr<StateWrapper> StateWrapperRef;
-
-
+/**
+ * A JS value the engine holds on to (array elements, deps, call results). Passed around by value, moving one is a
+ * pointer and a jsi::Value.
+ */
 class StateWrapper {
 private:
-
+    Runtime *_rt = nullptr;
     Value value;
 
 public:
-    Runtime &rt;
-    explicit StateWrapper(Runtime &rt, Value value) : rt(rt),
+    // An empty wrapper, tested with operator bool.
+    StateWrapper() = default;
+
+    StateWrapper(std::nullptr_t) {
+    }
+
+    explicit StateWrapper(Runtime &rt, Value value) : _rt(&rt),
                                                       value(std::move(value)) {
     };
 
-    static StateWrapperRef create(Runtime &rt, Value value) {
-        auto wrapper = std::make_unique<StateWrapper>(rt, std::move(value));
-        return wrapper;
+    StateWrapper(StateWrapper &&) noexcept = default;
+
+    StateWrapper &operator=(StateWrapper &&) noexcept = default;
+
+    static StateWrapper create(Runtime &rt, Value value) {
+        return StateWrapper(rt, std::move(value));
     }
 
-    void setValue(const StateWrapperRef &newValue) const {
-        auto valueObj = this->value.asObject(rt);
-        auto setValueFn = valueObj.getPropertyAsFunction(rt, "setValue");
+    Runtime &runtime() const {
+        return *_rt;
+    }
+
+    explicit operator bool() const {
+        return _rt != nullptr;
+    }
+
+    void setValue(const StateWrapper &newValue) const {
+        auto &rt = *_rt;
+        const auto cell = StateCell::from(rt, value);
+        if (!cell) return;
 
-        auto &incoming = newValue->value;
+        auto &incoming = newValue.value;
         if (incoming.isObject()) {
             auto valObj = incoming.asObject(rt);
             if (valObj.isFunction(rt)) {
-                auto prevValue = valueObj.getProperty(rt, "value");
-                auto result = valObj.asFunction(rt).call(rt, prevValue);
-                setValueFn.call(rt, result);
+                cell->store(rt, valObj.asFunction(rt).call(rt, cell->current()));
                 return;
             }
         }
-        setValueFn.call(rt, incoming);
+        cell->store(rt, incoming);
     }
 
 
-    [[nodiscard]] StateWrapperRef getInternalValue() const {
-        auto value = this->value.asObject(rt).getProperty(rt, "value");
-        return create(rt, std::move(value));
+    // The value inside the state cell, without wrapping it.
+    [[nodiscard]] Value internalValue() const {
+        auto &rt = *_rt;
+        const auto cell = StateCell::from(rt, value);
+        return cell ? Value(rt, cell->current()) : Value::undefined();
+    }
+
+    [[nodiscard]] StateWrapper getInternalValue() const {
+        auto &rt = *_rt;
+        const auto cell = StateCell::from(rt, value);
+        return create(rt, cell ? Value(rt, cell->current()) : Value::undefined());
     }
 
     [[nodiscard]] Value getValue() const {
-        return Value(rt, value);
+        return Value(*_rt, value);
     }
 
-    [[nodiscard]] const Value &getValueRef() {
+    [[nodiscard]] const Value &getValueRef() const {
         return value;
     }
 
-    bool equals(StateWrapper *other) const {
-        return Value::strictEquals(rt, value, other->value);
+    bool equals(const StateWrapper &other) const {
+        return Value::strictEquals(*_rt, value, other.value);
     }
-    bool equals(Value &other) {
-        return Value::strictEquals(rt, value, other);
+
+    bool equals(const Value &other) const {
+        return Value::strictEquals(*_rt, value, other);
     }
+
     template<typename... Args>
-    StateWrapperRef call(Args... args) {
+    StateWrapper call(Args... args) const {
+        auto &rt = *_rt;
         auto result = value.asObject(rt).asFunction(rt).call(rt, std::forward<Args>(args)...);
         return create(rt, std::move(result));
     }
 
     [[nodiscard]] bool isStateVariable() const {
-        return value.asObject(rt).hasProperty(rt, "_isStateVariable");
+        return StateCell::is(*_rt, value);
     }
 
     [[nodiscard]] bool hasValue() const {
@@ -0,0 +1,56 @@
+#include "StyleHostObject.h"
+
+#include "Engine.h"
+#include "HermesPropMap.h"
+#include "../../utils/css/CssUtils.h"
+
+const HermesPropMap *StyleHostObject::styleMap(const Widget &widget) const {
+    return static_cast<const HermesPropMap *>(widget.styleObject().get());
+}
+
+const Object *StyleHostObject::styleObject() const {
+    const auto widget = engine->resolveWidget(handle);
+    if (!widget || !widget->styleObject()) return nullptr;
+    return &styleMap(*widget)->getHermesValue();
+}
+
+Value StyleHostObject::get(Runtime &rt, const PropNameID &name) {
+    // Reads come from the style object, native writes are mirrored there.
+    const auto object = styleObject();
+    if (!object) return Value::undefined();
+    return object->getProperty(rt, name);
+}
+
+void StyleHostObject::set(Runtime &rt, const PropNameID &name, const Value &value) {
+    const auto widget = engine->resolveWidget(handle);
+    if (!widget) return;
+    StyleProperty property;
+    // Unknown properties are ignored like the DOM does.
+    if (!PropNameCache::styleProperty(rt, name, property)) return;
+
+    if (value.isNumber()) {
+        widget->setStyleProperty(property, static_cast<float>(value.getNumber()));
+    } else if (value.isString()) {
+        widget->setStyleProperty(property, value.getString(rt).utf8(rt));
+    } else if (value.isUndefined() || value.isNull()) {
+        // Resets the property to its default, the mirror write deletes the key.
+        widget->setStyleProperty(property, std::string_view());
+    } else {
+        throw JSError(rt, "style." + name.utf8(rt) + " must be a string or a number");
+    }
+    // The style object only matters to reads and the next prop diff, both flush it.
+    if (widget->styleObject()) styleMap(*widget)->defer(name, value);
+}
+
+std::vector<PropNameID> StyleHostObject::getPropertyNames(Runtime &rt) {
+    std::vector<PropNameID> names;
+    const auto object = styleObject();
+    if (!object) return names;
+    const auto keys = object->getPropertyNames(rt);
+    const size_t count = keys.size(rt);
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        names.emplace_back(PropNameID::forString(rt, keys.getValueAtIndex(rt, i).getString(rt)));
+    }
+    return names;
+}
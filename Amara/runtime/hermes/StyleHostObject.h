@@ -0,0 +1,36 @@
+#ifndef STYLEHOSTOBJECT_H
+#define STYLEHOSTOBJECT_H
+
+#include <memory>
+
+#include <jsi/jsi.h>
+#include "../../ui/Widget.h"
+using namespace facebook::jsi;
+class HermesEngine;
+class HermesPropMap;
+
+/**
+ * `widget.style` as seen from compiled effects. Writing a property updates that field of the widget's computed style
+ * and marks it dirty, instead of going through a prop diff and a full style reparse.
+ */
+class StyleHostObject : public HostObject {
+public:
+    StyleHostObject(HermesEngine *engine, WidgetHandle handle) : engine(engine), handle(handle) {
+    }
+
+    Value get(Runtime &rt, const PropNameID &name) override;
+
+    void set(Runtime &rt, const PropNameID &name, const Value &value) override;
+
+    std::vector<PropNameID> getPropertyNames(Runtime &rt) override;
+
+private:
+    const HermesPropMap *styleMap(const Widget &widget) const;
+
+    const Object *styleObject() const;
+
+    HermesEngine *engine;
+    WidgetHandle handle;
+};
+
+#endif //STYLEHOSTOBJECT_H
@@ -3,96 +3,90 @@
 //
 
 #include "WidgetHostWrapper.h"
+
+#include <cmath>
+
 #include "HermesWidgetHolder.h"
 #include "Engine.h"
 #include "HermesArray.h"
+#include "StyleHostObject.h"
 #include "../utils/ScopedTimer.h"
 
-static const char *CHILDREN_ID = "CHILDREN_SPECIAL_ID";
+
+WidgetHostMethods::WidgetHostMethods(Runtime &rt) {
+    using Method = Value (WidgetHostWrapper::*)(Runtime &, const Value *, size_t);
+    auto add = [&](const char *name, Method method, unsigned int paramCount, BridgeCall call) {
+        functions.emplace_back(Function::createFromHostFunction(
+            rt, PropNameID::forAscii(rt, name), paramCount,
+            [method, name, call](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) -> Value {
+                BridgeScope scope(call);
+                if (!thisValue.isObject() || !thisValue.asObject(rt).isHostObject<WidgetHostWrapper>(rt)) {
+                    throw JSError(rt, std::string(name) + " must be called on a widget");
+                }
+                auto wrapper = thisValue.asObject(rt).asHostObject<WidgetHostWrapper>(rt);
+                return ((*wrapper).*method)(rt, args, count);
+            }));
+    };
+#define ADD_WIDGET_METHOD(name, method, paramCount, call) \
+    add(name, &WidgetHostWrapper::method, paramCount, BridgeCall::call);
+    WIDGET_HOST_METHODS(ADD_WIDGET_METHOD)
+#undef ADD_WIDGET_METHOD
+}
+
+static constexpr NameTable<WidgetHostMethods::PropertyCount> WIDGET_PROPERTY_NAMES({
+#define WIDGET_METHOD_NAME(name, method, paramCount, call) std::string_view(name),
+    WIDGET_HOST_METHODS(WIDGET_METHOD_NAME)
+#undef WIDGET_METHOD_NAME
+    std::string_view("style")
+});
+static_assert(WIDGET_PROPERTY_NAMES.valid(), "No perfect hash seed for the widget property names");
+
+WidgetHostMethods::Property WidgetHostMethods::find(Runtime &rt, const PropNameID &name) {
+    auto property = NoProperty;
+    withUtf8(rt, name, [&property](std::string_view text) {
+        property = static_cast<Property>(WIDGET_PROPERTY_NAMES.find(text));
+    });
+    return property;
+}
 
 Value WidgetHostWrapper::get(Runtime &runtime, const PropNameID &propName) {
-    auto name = propName.utf8(runtime);
-    if (name == "addText") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return addText(rt, args, count);
-            });
-    }
-    if (name == "addChild") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return addChild(rt, args, count);
-            });
-    }
-    if (name == "insertChild") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return insertChild(rt, args, count);
-            });
-    } else if (name == "addStaticChild") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return addStaticChild(rt, args, count);
-            });
-    }
-    if (name == "insertChildren") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return insertChildren(rt, args, count);
-            });
-    }
-    if (name == "removeChildren") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return insertChildren(rt, args, count);
-            });
-    }
-    if (name == "setChild") {
-        static int i = 0;
-        i += 1;
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return setChild(rt, args, count);
-            });
-    }
-    if (name == "removeChild") {
-        return Function::createFromHostFunction(
-            runtime,
-            propName,
-            1, [this](Runtime &rt, const Value &thisValue, const Value *args, const size_t count) {
-                return removeChild(rt, args, count);
-            });
+    const auto property = WidgetHostMethods::find(runtime, propName);
+    if (property == WidgetHostMethods::Style) {
+        if (!style) {
+            style = Object::createFromHostObject(runtime, std::make_shared<StyleHostObject>(engine, handle));
+        }
+        return Value(runtime, *style);
     }
-    return Value::undefined();
+    if (property == WidgetHostMethods::NoProperty) return Value::undefined();
+    return engine->widgetMethods().function(runtime, property);
 }
 
 void WidgetHostWrapper::set(Runtime &runtime, const PropNameID &name, const Value &value) {
+    if (WidgetHostMethods::find(runtime, name) != WidgetHostMethods::Style) return;
+    if (!value.isObject()) {
+        throw JSError(runtime, "style must be an object");
+    }
+    widget(runtime).setStyleObject(std::make_unique<HermesPropMap>(runtime, engine->propNames(), Value(runtime, value)));
+}
+
+// Slots index the widget's slot tables, so anything but an integer below its component's slot count is rejected.
+static ChildSlot slotArgument(Runtime &rt, const Value &value, Widget &widget, const char *function) {
+    const size_t slotCount = widget.component()->slotCount();
+    if (value.isNumber()) {
+        const double slot = value.asNumber();
+        if (slot >= 0 && slot < static_cast<double>(slotCount) && std::trunc(slot) == slot) {
+            return static_cast<ChildSlot>(slot);
+        }
+    }
+    throw JSError(rt, std::string(function) + " expects an integer slot number below " + std::to_string(slotCount));
 }
 
 Value WidgetHostWrapper::addText(Runtime &rt, const Value *args, const size_t count) {
     if (count != 1 || !args[0].isString()) {
         throw JSError(rt, "addText function accept one argument only and its type must be string");
     }
-    auto widget = nativeWidget.lock();
-    auto textWidget = widget->as<TextWidget>();
-    if (!textWidget) {
-        throw JSError(rt, "You cannot use addText over a non text widget");
-    }
-    textWidget->addText(args[0].asString(rt).utf8(rt));
+    auto &textWidget = widgetAs<TextWidget>(rt, "You cannot use addText over a non text widget");
+    textWidget.addText(args[0].asString(rt).utf8(rt));
     return Value::undefined();
 }
 
@@ -100,11 +94,7 @@ Value WidgetHostWrapper::addChild(Runtime &rt, const Value *args, const size_t c
     if (count != 1 || !args[0].isObject()) {
         throw JSError(rt, "addChild function accept one argument only and its type must be an object");
     }
-    auto widget = nativeWidget.lock();
-    auto containerWidget = widget->as<ContainerWidget>();
-    if (!containerWidget) {
-        throw JSError(rt, "You cannot use addChild over a non container widget");
-    }
+    auto &containerWidget = widgetAs<ContainerWidget>(rt, "You cannot use addChild over a non container widget");
     Object obj = args[0].asObject(rt);
     // I am pretty sure we won't need that but just in case
     if (!obj.isHostObject(rt) && obj.hasProperty(rt, "$$internalComponent")) {
@@ -112,8 +102,7 @@ Value WidgetHostWrapper::addChild(Runtime &rt, const Value *args, const size_t c
 
     }
     auto child = obj.asHostObject<WidgetHostWrapper>(rt);
-    auto childWidget = child->getNativeWidget();
-    containerWidget->addChild(childWidget);
+    containerWidget.addChild(child->widget(rt));
     return Value::undefined();
 }
 
@@ -121,51 +110,50 @@ Value WidgetHostWrapper::addStaticChild(Runtime &rt, const Value *args, size_t c
     if (count != 1 || !args[0].isObject()) {
         throw JSError(rt, "addChild function accept one argument only and its type must be an object");
     }
-    auto widget = nativeWidget.lock();
-    auto containerWidget = widget->as<ContainerWidget>();
-    if (!containerWidget) {
-        throw JSError(rt, "You cannot use addChild over a non container widget");
-    }
+    auto &containerWidget = widgetAs<ContainerWidget>(rt, "You cannot use addChild over a non container widget");
     auto holder = engine->getWidgetHolder(args[0]);
+    if (holder->hasSlot() && holder->slot() >= containerWidget.component()->slotCount()) {
+        throw JSError(rt, "addStaticChild got a slot outside the component's slots");
+    }
 
-    containerWidget->addStaticChild(engine, std::move(holder));
+    containerWidget.addStaticChild(engine, std::move(holder));
     return Value::undefined();
 }
 
 Value WidgetHostWrapper::insertChild(Runtime &rt, const Value *args, size_t count) {
-    if (count != 2 || !args[0].isString()) {
-        throw JSError(rt, "insertChild function accept two argument only and the first argument must be a string ID");
+    if (count != 2) {
+        throw JSError(rt, "insertChild function accept two argument only and the first argument must be a slot number");
     }
-    auto widget = nativeWidget.lock();
-    auto id = args[0].asString(rt).utf8(rt);
-    if (widget->is<TextWidget>()) {
+    auto &widget = this->widget(rt);
+    const auto slot = slotArgument(rt, args[0], widget, "insertChild");
+    if (widget.is<TextWidget>()) {
         auto &arg = args[1];
         std::string text;
         if (arg.isString()) {
             text = arg.asString(rt).utf8(rt);
         } else {
-            text = arg.asObject(rt).getProperty(rt, "toString").asObject(rt).asFunction(rt).call(rt).asString(rt).
+            BridgeScope scope(BridgeCall::CallToString);
+            text = arg.asObject(rt).getProperty(rt, engine->propNames()[PropKey::ToString]).asObject(rt).asFunction(rt).call(rt).asString(rt).
                     utf8(rt);
         }
-        widget->as<TextWidget>()->insertChild(id, text);
+        widget.as<TextWidget>()->insertChild(slot, text);
         return Value::undefined();
     }
-    auto containerWidget = widget->as<ContainerWidget>();
+    auto containerWidget = widget.as<ContainerWidget>();
     if (!containerWidget) {
         throw JSError(rt, "You cannot use insertChild over a non container widget");
     }
     if (args[1].isObject()) {
         auto obj = args[1].asObject(rt);
         if (obj.isHostObject<WidgetHostWrapper>(rt)) {
-            auto newWidget = obj.asHostObject<WidgetHostWrapper>(rt)->nativeWidget.lock();
-            if (!newWidget->is<HolderWidget>()) {
-                throw JSError(rt, "You cannot use insertChild non static child or a holder");
-            }
-            auto holder = newWidget->as<HolderWidget>();
-            containerWidget->insertChild(std::move(id), holder->child);
+            auto &holder = obj.asHostObject<WidgetHostWrapper>(rt)->widgetAs<HolderWidget>(
+                rt, "You cannot use insertChild non static child or a holder");
+            auto child = engine->resolveWidget(holder.child);
+            if (!child) throw JSError(rt, "insertChild got a holder without a child");
+            containerWidget->insertSlot(slot, *child);
         } else {
             auto holder = engine->getWidgetHolder(args[1]);
-            containerWidget->insertChild(engine, std::move(id), std::move(holder));
+            containerWidget->insertSlot(engine, slot, std::move(holder));
         }
     } else {
         //State variable
@@ -176,48 +164,64 @@ Value WidgetHostWrapper::insertChild(Runtime &rt, const Value *args, size_t coun
 
 Value WidgetHostWrapper::insertChildren(Runtime &rt, const Value *args, size_t count) {
     auto &children = args[0];
-    auto widget = nativeWidget.lock();
-    assert(widget->is<ContainerWidget>() && "Widget is not a container widget");
-    auto containerWidget = widget->as<ContainerWidget>();
+    auto &containerWidget = widgetAs<ContainerWidget>(rt, "insertChildren must be called on a container widget");
     auto arr = std::make_unique<HermesArray>(rt, Value(rt, children));
-    auto emptyProps = Value();
-    std::string type = "component";
-    auto holder = engine->createComponent(type, std::make_unique<HermesPropMap>(rt, Object(rt)));
-    auto holderContainer = holder->as<ContainerWidget>();
+    std::vector<std::unique_ptr<WidgetHolder> > holders;
+    holders.reserve(arr->size());
     for (int i = 0; i < arr->size(); ++i) {
         auto val = arr->getValue(i);
-        auto w = engine->getWidgetHolder(val)->execute(engine);
-        holderContainer->addChild(w);
+        holders.push_back(engine->getWidgetHolder(val));
+    }
+    // Effects re-run outside of their component, widgets created here belong to the one that owns the container.
+    auto *component = containerWidget.component();
+    engine->plugComponent(component->shared_from_this());
+    // The children are rendered into a holder the container owns, a re-render reconciles them in place.
+    auto existing = containerWidget.ownedSlotChild(CHILDREN_SLOT);
+    if (auto holderContainer = existing ? existing->as<ContainerWidget>() : nullptr) {
+        component->reconcileWidgetHolders(*holderContainer, std::move(holders));
+    } else {
+        std::string type = "component";
+        auto holder = engine->createComponent(type, std::make_unique<HermesPropMap>(rt, engine->propNames(), Object(rt)));
+        holderContainer = holder->as<ContainerWidget>();
+        for (const auto &widgetHolder: holders) {
+            holderContainer->addChild(*widgetHolder->execute(engine));
+        }
+        containerWidget.insertSlot(CHILDREN_SLOT, *holder, false);
     }
-    containerWidget->insertChild(CHILDREN_ID, holder);
+    engine->unplugComponent();
     return Value::undefined();
 }
 
 Value WidgetHostWrapper::removeChildren(Runtime &rt, const Value *args, size_t count) {
-    auto widget = nativeWidget.lock();
-    assert(widget->is<ContainerWidget>() && "Widget is not a container widget");
-    auto containerWidget = widget->as<ContainerWidget>();
-    std::string id = CHILDREN_ID;
-    containerWidget->removeChild(id);
+    auto &containerWidget = widgetAs<ContainerWidget>(rt, "removeChildren must be called on a container widget");
+    containerWidget.removeSlot(CHILDREN_SLOT);
+    return Value::undefined();
 }
 
 Value WidgetHostWrapper::setChild(Runtime &rt, const Value *args, size_t count) {
-    auto widget = nativeWidget.lock();
-    assert(widget->is<HolderWidget>() && "Widget is not a container widget");
-    auto holderWidget = widget->as<HolderWidget>();
+    auto &holderWidget = widgetAs<HolderWidget>(rt, "setChild must be called on a holder widget");
     auto widgetHolder = engine->getWidgetHolder(args[0]);
-    holderWidget->setChild(engine, std::move(widgetHolder));
+    holderWidget.setChild(engine, std::move(widgetHolder));
     return Value::undefined();
 }
 
 Value WidgetHostWrapper::removeChild(Runtime &rt, const Value *args, size_t count) {
-    auto widget = nativeWidget.lock()->as<ContainerWidget>();
-
-    auto id = args[0].asString(rt).utf8(rt);
-    widget->removeChild(id);
+    auto &widget = widgetAs<ContainerWidget>(rt, "removeChild must be called on a container widget");
+    if (count < 1) {
+        throw JSError(rt, "removeChild expects the slot number of the child");
+    }
+    widget.removeSlot(slotArgument(rt, args[0], widget, "removeChild"));
     return Value::undefined();
 }
 
-SharedWidget WidgetHostWrapper::getNativeWidget() const {
-    return nativeWidget.lock();
+Widget &WidgetHostWrapper::widget(Runtime &rt) const {
+    auto *widget = engine->resolveWidget(handle);
+    if (!widget) {
+        throw JSError(rt, "This widget was already destroyed");
+    }
+    return *widget;
+}
+
+Widget *WidgetHostWrapper::getNativeWidget() const {
+    return engine->resolveWidget(handle);
 }
@@ -5,15 +5,30 @@
 #ifndef WIDGETHOSTWRAPPER_H
 #define WIDGETHOSTWRAPPER_H
 
+#include <optional>
+
 #include "../../ui/Widget.h"
+#include "../../utils/BridgeStats.h"
+#include "../../utils/NameTable.h"
 #include <jsi/jsi.h>
 class HermesEngine;
 #define JSI_FUNCTION(name) Value name(Runtime &rt, const Value *args, size_t count)
 using namespace facebook::jsi;
 
+// name, member function, param count, BridgeCall.
+#define WIDGET_HOST_METHODS(X) \
+    X("insertChild", insertChild, 2, InsertChild) \
+    X("addChild", addChild, 1, AddChild) \
+    X("addStaticChild", addStaticChild, 1, AddStaticChild) \
+    X("setChild", setChild, 1, SetChild) \
+    X("removeChild", removeChild, 1, RemoveChild) \
+    X("addText", addText, 1, AddText) \
+    X("insertChildren", insertChildren, 1, InsertChildren) \
+    X("removeChildren", removeChildren, 0, RemoveChildren)
+
 class WidgetHostWrapper : public HostObject {
 public:
-    WidgetHostWrapper(HermesEngine *engine, const SharedWidget &widget): engine(engine), nativeWidget(widget) {
+    WidgetHostWrapper(HermesEngine *engine, WidgetHandle handle): engine(engine), handle(handle) {
     }
 
     ~WidgetHostWrapper() override = default;
@@ -39,11 +54,56 @@ public:
 
     JSI_FUNCTION(removeChild);
 
-    SharedWidget getNativeWidget() const;
+    // nullptr once the widget was destroyed.
+    Widget *getNativeWidget() const;
 
 private:
+    // Throws a JSError when JS still holds a widget that was destroyed.
+    Widget &widget(Runtime &rt) const;
+
+    template<typename T>
+    T &widgetAs(Runtime &rt, const char *error) const {
+        auto *widget = dynamic_cast<T *>(&this->widget(rt));
+        if (!widget) throw JSError(rt, error);
+        return *widget;
+    }
+
     HermesEngine *engine;
-    std::weak_ptr<Widget> nativeWidget;
+    WidgetHandle handle;
+    // Created on the first `widget.style` read, later reads return the same object.
+    std::optional<Object> style;
+};
+
+/**
+ * Host functions shared by every widget wrapper. They are created once per runtime and resolve the widget from
+ * `this`, so reading `parent.addChild` neither allocates a function nor goes through a chain of name compares.
+ */
+class WidgetHostMethods {
+public:
+    // Indices of WIDGET_HOST_METHODS, then the `style` property.
+    enum Property : uint8_t {
+#define WIDGET_METHOD_PROPERTY(name, method, paramCount, call) call,
+        WIDGET_HOST_METHODS(WIDGET_METHOD_PROPERTY)
+#undef WIDGET_METHOD_PROPERTY
+        Style,
+        PropertyCount,
+        NoProperty = NameTable<PropertyCount>::NOT_FOUND
+    };
+
+    explicit WidgetHostMethods(Runtime &rt);
+
+    WidgetHostMethods(const WidgetHostMethods &) = delete;
+
+    // One hash of the name against a table built at compile time, NoProperty if widgets don't have it.
+    static Property find(Runtime &rt, const PropNameID &name);
+
+    // The shared function of a method property.
+    Value function(Runtime &rt, Property property) const {
+        return Value(rt, functions[property]);
+    }
+
+private:
+    std::vector<Function> functions;
 };
 
 
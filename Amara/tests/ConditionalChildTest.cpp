@@ -0,0 +1,71 @@
+// Removes a conditional child, then has the list reconciler replace its component with a plain div. The component's
+// root div must not be reused for the plain div, the component is unmounted and its cleanup runs. Runs
+// js/conditionalChild.js.
+
+#include <iostream>
+
+#include "../runtime/hermes/BundleLoader.h"
+#include "../runtime/hermes/InstallEngine.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (condition) return;
+    std::cerr << "FAILED: " << what << std::endl;
+    ++failures;
+}
+
+static void run(HermesEngine &engine, const char *action) {
+    auto &rt = engine.getRuntime();
+    rt.global().getPropertyAsObject(rt, "testActions").getPropertyAsFunction(rt, action).call(rt);
+    while (engine.hasPendingWork()) {
+        engine.tick();
+    }
+}
+
+// The div listConciliar rendered under the app's root.
+static ContainerWidget *listItem(HermesEngine &engine) {
+    auto root = engine.root() ? engine.root()->as<ContainerWidget>() : nullptr;
+    auto list = root && root->hasChildren() ? root->childAt(0)->as<ContainerWidget>() : nullptr;
+    return list && list->hasChildren() ? list->childAt(0)->as<ContainerWidget>() : nullptr;
+}
+
+static size_t emptyChildren(const ContainerWidget &container) {
+    size_t empty = 0;
+    for (size_t i = 0; i < container.children().size(); ++i) {
+        if (!container.childAt(i)) ++empty;
+    }
+    return empty;
+}
+
+int main() {
+    auto engine = installEngine();
+    const auto bundle = BundleLoader().load(AMARA_TEST_JS_DIR "/conditionalChild.js");
+    if (!bundle) {
+        std::cerr << "Couldn't load conditionalChild.js" << std::endl;
+        return 1;
+    }
+
+    try {
+        engine->execute(*bundle);
+        auto panel = listItem(*engine);
+        check(panel && panel->children().size() == 2 && emptyChildren(*panel) == 0, "the panel renders both children");
+
+        run(*engine, "hide");
+        check(panel && listItem(*engine) == panel && emptyChildren(*panel) == 1,
+              "hiding the conditional child leaves an empty slot");
+
+        run(*engine, "plain");
+        auto plain = listItem(*engine);
+        check(plain && plain->children().size() == 1 && emptyChildren(*plain) == 0, "the plain div renders its child");
+        auto &rt = engine->getRuntime();
+        const auto cleanedUp = rt.global().getPropertyAsObject(rt, "testActions").getProperty(rt, "cleanedUp");
+        check(cleanedUp.isBool() && cleanedUp.getBool(), "the panel is unmounted and its cleanup runs");
+    } catch (JSError &error) {
+        std::cerr << error.getMessage() << "\n" << error.getStack() << std::endl;
+        return 1;
+    }
+
+    engine->shutdown();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+// Re-renders a component that forwards its children with insertChildren. Each re-render has to reconcile the children
+// holder it inserted the first time instead of inserting a new one. Runs js/insertChildren.js.
+
+#include <iostream>
+
+#include "../runtime/hermes/BundleLoader.h"
+#include "../runtime/hermes/InstallEngine.h"
+#include "../ui/ComponentContext.h"
+
+static constexpr int RERENDERS = 10;
+
+static int failures = 0;
+
+static void check(bool condition, const char *what) {
+    if (condition) return;
+    std::cerr << "FAILED: " << what << std::endl;
+    ++failures;
+}
+
+static void run(HermesEngine &engine, const char *action) {
+    auto &rt = engine.getRuntime();
+    rt.global().getPropertyAsObject(rt, "testActions").getPropertyAsFunction(rt, action).call(rt);
+    while (engine.hasPendingWork()) {
+        engine.tick();
+    }
+}
+
+// The root div Wrapper rendered under the app's root.
+static ContainerWidget *wrapper(HermesEngine &engine) {
+    auto root = engine.root() ? engine.root()->as<ContainerWidget>() : nullptr;
+    return root && root->hasChildren() ? root->childAt(0)->as<ContainerWidget>() : nullptr;
+}
+
+static size_t liveWidgets(HermesEngine &engine) {
+    const auto &stats = engine.poolStats();
+    return stats.allocated + stats.reused - stats.released;
+}
+
+int main() {
+    auto engine = installEngine();
+    const auto bundle = BundleLoader().load(AMARA_TEST_JS_DIR "/insertChildren.js");
+    if (!bundle) {
+        std::cerr << "Couldn't load insertChildren.js" << std::endl;
+        return 1;
+    }
+
+    try {
+        engine->execute(*bundle);
+        auto parent = wrapper(*engine);
+        auto holder = parent && parent->hasChildren() ? parent->childAt(0) : nullptr;
+        check(holder && holder->as<ContainerWidget>() && holder->as<ContainerWidget>()->children().size() == 2,
+              "the children are rendered into a holder");
+        if (!parent || !holder) {
+            engine->shutdown();
+            return 1;
+        }
+        const size_t widgets = parent->component()->widgetCount();
+        const size_t live = liveWidgets(*engine);
+
+        for (int i = 0; i < RERENDERS; ++i) {
+            run(*engine, "rerender");
+        }
+        check(wrapper(*engine) == parent && parent->children().size() == 1, "the wrapper keeps a single child");
+        check(parent->childAt(0) == holder, "the children holder is reconciled in place");
+        check(holder->as<ContainerWidget>()->children().size() == 2, "the holder keeps both children");
+        check(parent->component()->widgetCount() == widgets, "re-rendering doesn't add widgets to the component");
+        check(liveWidgets(*engine) == live, "re-rendering doesn't leak widgets");
+    } catch (JSError &error) {
+        std::cerr << error.getMessage() << "\n" << error.getStack() << std::endl;
+        return 1;
+    }
+
+    engine->shutdown();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// A panel that drops a conditional child and is then replaced by a plain div, written the way the JSX transform
+// compiles it. ConditionalChildTest.cpp drives it through the actions published on globalThis.testActions.
+
+function Panel() {
+    beginComponentInit("panelTest", 3);
+    const [show, setShow] = useState(true);
+    globalThis.testActions.hide = () => setShow(false);
+    effect(() => {
+        return () => {
+            globalThis.testActions.cleanedUp = true;
+        };
+    }, []);
+
+    {
+        const _parent = createElement("div", {});
+        const _element = createElement("text", {});
+        _element.insertChild(1, "Always");
+        _parent.addChild(_element);
+        const _holder = createElement("holder", {});
+        _holder.setChild({
+            "$$internalComponent": true,
+            "component": "text",
+            "props": {
+                "children": ["Sometimes"]
+            }
+        });
+        effect(() => {
+            if (toRaw(show)) {
+                _parent.insertChild(2, _holder);
+            } else {
+                _parent.removeChild(2);
+            }
+        }, [show]);
+        endComponent();
+        return _parent;
+    }
+}
+
+function App() {
+    beginComponentInit("appTest");
+    const [plain, setPlain] = useState(false);
+
+    globalThis.testActions = {
+        plain: () => setPlain(true)
+    };
+
+    {
+        const _parent = createElement("div", {});
+        const _list = createElement("component", {});
+        effect(() => {
+            const current = toRaw(plain);
+            listConciliar(_list, [0], () => current ? {
+                "$$internalComponent": true,
+                "component": "div",
+                "props": {
+                    "children": [{
+                        "$$internalComponent": true,
+                        "component": "text",
+                        "props": {
+                            "children": ["Plain"]
+                        }
+                    }]
+                }
+            } : {
+                "$$internalComponent": false,
+                "component": Panel,
+                "props": {}
+            });
+        }, [plain]);
+        _parent.addChild(_list);
+        endComponent();
+        return _parent;
+    }
+}
+
+render(App);
@@ -0,0 +1,56 @@
+// A component that forwards its children through insertChildren from a state effect, written the way the JSX transform
+// compiles it. InsertChildrenTest.cpp re-renders it through globalThis.testActions.rerender.
+
+function Wrapper({children}) {
+    beginComponentInit("wrapperTest", 1);
+    const [tick, setTick] = useState(0);
+    let ticks = 0;
+    globalThis.testActions.rerender = () => setTick(++ticks);
+
+    {
+        const _parent = createElement("div", {});
+        effect(() => {
+            _parent.insertChildren(children);
+        }, [tick]);
+        endComponent();
+        return _parent;
+    }
+}
+
+function App() {
+    beginComponentInit("appTest", 2);
+    globalThis.testActions = {};
+
+    {
+        const _parent = createElement("div", {});
+        _parent.insertChild(1, {
+            "$$internalComponent": false,
+            "component": Wrapper,
+            "props": {
+                "children": [{
+                    "$$internalComponent": true,
+                    "component": "text",
+                    "props": {
+                        "children": ["First"]
+                    }
+                }, {
+                    "$$internalComponent": true,
+                    "component": "div",
+                    "props": {
+                        "children": [{
+                            "$$internalComponent": true,
+                            "component": "text",
+                            "props": {
+                                "children": ["Second"]
+                            }
+                        }]
+                    }
+                }]
+            }
+        });
+        endComponent();
+        return _parent;
+    }
+}
+
+render(App);
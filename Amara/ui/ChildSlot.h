@@ -0,0 +1,15 @@
+#ifndef CHILDSLOT_H
+#define CHILDSLOT_H
+
+#include <cstdint>
+
+// Dense per component number the JSX transform gives every inserted or static child, in place of a string ID.
+using ChildSlot = uint32_t;
+
+constexpr ChildSlot NO_CHILD_SLOT = UINT32_MAX;
+// Upper bound for a component's slot count, slot tables are sized to it so a bogus count can't allocate unbounded.
+constexpr ChildSlot MAX_CHILD_SLOTS = 1u << 16;
+// Reserved for the component's `children` prop (insertChildren/removeChildren), compiled slots start at 1.
+constexpr ChildSlot CHILDREN_SLOT = 0;
+
+#endif //CHILDSLOT_H
@@ -1,120 +1,235 @@
 #include "ComponentContext.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "../runtime/WidgetHolder.h"
 #include "../runtime/IEngine.h"
 #include "Widget.h"
+#include "../utils/BridgeStats.h"
 #include "../utils/ScopedTimer.h"
+#include "../utils/Trace.h"
 
 // Currently I am using a placeholder useState. The real implementation should be a queue to handle setStates in order.
-std::tuple<StateWrapper *, SetStateFunction> ComponentContext::useState(std::unique_ptr<StateWrapper> value,
-                                                                        EmptyFunction notifier) {
-    StateWrapper *wrapper;
+std::tuple<Value, SetStateFunction> ComponentContext::useState(StateWrapper value, EmptyFunction notifier) {
     size_t currentIndex;
     if (_reconciliationStarted) {
-        State &state = states[hookCount];
-        wrapper = state.object.get();
         currentIndex = hookCount++;
     } else {
-        State state{std::move(value)};
-        currentIndex = states.capacity();
-        wrapper = state.object.get();
-        states.push_back(std::move(state));
+        currentIndex = states.size();
+        states.push_back(State{std::move(value)});
+        // Deps of effects declared before this state, they depend on it from now on.
+        for (size_t i = 0; i < unresolvedDeps.size();) {
+            if (states[currentIndex].object.equals(unresolvedDeps[i].dep)) {
+                indexEffectDep(currentIndex, unresolvedDeps[i].effect);
+                unresolvedDeps[i] = std::move(unresolvedDeps.back());
+                unresolvedDeps.pop_back();
+            } else {
+                ++i;
+            }
+        }
     }
 
 
     SetStateFunction setState = [this, currentIndex, notifier=std::move(notifier)
-            ](std::unique_ptr<StateWrapper> newValue) {
+            ](StateWrapper newValue) {
+        // Closures held by JS can outlive the component.
+        if (_unmounted) return;
         auto &state = states[currentIndex];
-        // Using the pointer directly as we cannot pass the unique pointer inside.
-        std::unique_ptr<StateWrapper> valueToUse;
-        if (newValue->getValueRef().isObject()) {
-            auto obj = newValue->getValueRef().asObject(newValue->rt);
-            if (obj.isFunction(newValue->rt)) {
-                valueToUse = newValue->call(state.object->getInternalValue()->getValue());
-            } else {
-                valueToUse = std::move(newValue);
-            }
+        auto &rt = newValue.runtime();
+        // setStates before the next frame are batched into one update, so an updater has to see the value the
+        // previous setState queued rather than the committed one.
+        const bool hasPending = static_cast<bool>(state.pending);
+        StateWrapper valueToUse;
+        if (newValue.getValueRef().isObject() && newValue.getValueRef().getObject(rt).isFunction(rt)) {
+            BridgeScope scope(BridgeCall::CallStateUpdater);
+            valueToUse = hasPending
+                             ? newValue.call(state.pending.getValue())
+                             : newValue.call(state.object.internalValue());
         } else {
             valueToUse = std::move(newValue);
         }
-        if (state.object->equals(valueToUse.get())) {
+        const bool unchanged = hasPending
+                                   ? valueToUse.equals(state.pending.getValueRef())
+                                   : valueToUse.equals(state.object.internalValue());
+        if (unchanged) {
             return;
         }
 
         //Notify parent if needed
         notifier();
-        toBeUpdated[currentIndex] = std::move(valueToUse);
+        if (!hasPending) pendingSlots.push_back(currentIndex);
+        state.pending = std::move(valueToUse);
         dirty = true;
     };
 
-    return {wrapper, std::move(setState)};
+    // A copy of the state's cell, `states` grows with every hook so nothing may point into it.
+    return {states[currentIndex].object.getValue(), std::move(setState)};
 }
 
-void ComponentContext::effect(StateWrapperRef fn, std::vector<StateWrapperRef> deps) {
+void ComponentContext::effect(StateWrapper fn, std::vector<StateWrapper> deps) {
     if (_reconciliationStarted) {
-        fn->call();
+        BridgeScope scope(BridgeCall::CallEffect);
+        fn.call();
         return;
     }
     //The initial register call
-    auto result = fn->call();
+    auto result = [&] {
+        BridgeScope scope(BridgeCall::CallEffect);
+        return fn.call();
+    }();
+
+    // Resolving deps to state slots costs a comparison per state here, once, instead of on every update.
+    const size_t effectIndex = effects.size();
+    for (auto &dep: deps) {
+        size_t slot = 0;
+        while (slot < states.size() && !states[slot].object.equals(dep)) ++slot;
+        if (slot < states.size()) {
+            indexEffectDep(slot, effectIndex);
+        } else {
+            // No state yet, a later useState may still declare it.
+            unresolvedDeps.push_back({effectIndex, std::move(dep)});
+        }
+    }
+    effects.emplace_back(std::move(fn), std::move(result));
+}
 
-    effects.emplace_back(std::move(fn), std::move(deps), std::move(result));
+void ComponentContext::indexEffectDep(size_t slot, size_t effectIndex) {
+    if (stateEffects.size() <= slot) stateEffects.resize(slot + 1);
+    auto &dependents = stateEffects[slot];
+    if (std::find(dependents.begin(), dependents.end(), effectIndex) == dependents.end()) {
+        dependents.push_back(effectIndex);
+    }
 }
 
 
-void ComponentContext::_updateStates() {
-    std::vector<size_t> keysToErase;
-    for (auto &data: toBeUpdated) {
-        states[data.first].object->setValue(data.second);
-        updatedStates[data.first] = std::move(data.second);
-        keysToErase.push_back(data.first);
+ComponentContext::~ComponentContext() {
+    // Unlinked one at a time, letting the head go would destroy the list recursively. Widgets that outlive the
+    // component lose their link to it.
+    while (firstWidget) {
+        firstWidget->_component = nullptr;
+        auto next = std::move(firstWidget->nextInComponent);
+        if (next) next->previousInComponent = nullptr;
+        firstWidget = std::move(next);
     }
-    for (const auto &key: keysToErase) {
-        toBeUpdated.erase(key);
+}
+
+void ComponentContext::addWidget(const std::shared_ptr<Widget> &widget) {
+    assert(!widget->previousInComponent && !widget->nextInComponent && "Widget is already owned by a component");
+    if (firstWidget) firstWidget->previousInComponent = widget.get();
+    widget->nextInComponent = std::move(firstWidget);
+    firstWidget = widget;
+    ++_widgetCount;
+}
+
+std::shared_ptr<Widget> ComponentContext::releaseWidget(Widget &widget) {
+    auto &owner = widget.previousInComponent ? widget.previousInComponent->nextInComponent : firstWidget;
+    if (owner.get() != &widget) return nullptr;
+    auto released = std::move(owner);
+    owner = std::move(widget.nextInComponent);
+    if (owner) owner->previousInComponent = widget.previousInComponent;
+    widget.previousInComponent = nullptr;
+    --_widgetCount;
+    return released;
+}
+
+void ComponentContext::unmount() {
+    if (_unmounted) return;
+    TRACE_SCOPE(Update, "ComponentContext::unmount");
+    _unmounted = true;
+    // Cleanups run last declared first, while the widgets are still there.
+    for (auto it = effects.rbegin(); it != effects.rend(); ++it) {
+        if (!it->cleanup || !it->cleanup.hasValue()) continue;
+        BridgeScope scope(BridgeCall::CallEffectCleanup);
+        it->cleanup.call();
     }
+    dirty = false;
+}
+
+void ComponentContext::releaseWidgets(std::vector<WidgetHandle> &out) {
+    for (auto *widget = firstWidget.get(); widget; widget = widget->nextInComponent.get()) {
+        out.push_back(widget->handle());
+    }
+}
+
+// Swapped with an empty vector so the buffer goes back to the hook arena before it is released.
+template<typename T>
+static void dropStorage(std::pmr::vector<T> &values) {
+    std::pmr::vector<T>(values.get_allocator()).swap(values);
+}
+
+void ComponentContext::releaseHooks() {
+    dropStorage(effects);
+    dropStorage(states);
+    dropStorage(stateEffects);
+    dropStorage(unresolvedDeps);
+    dropStorage(effectsToRun);
+    dropStorage(pendingSlots);
+    dropStorage(updatedSlots);
+    hookArena.release();
+    componentObject = StateWrapper();
+}
+
+void ComponentContext::_updateStates() {
+    for (const size_t slot: pendingSlots) {
+        auto &state = states[slot];
+        state.object.setValue(state.pending);
+        state.pending = StateWrapper();
+        updatedSlots.push_back(slot);
+    }
+    pendingSlots.clear();
+}
+
+void ComponentContext::discardUpdate() {
+    dirty = !pendingSlots.empty();
+    updatedSlots.clear();
+    hookCount = 0;
 }
 
 void ComponentContext::update() {
     if (!dirty) {
-        updatedStates.clear();
+        updatedSlots.clear();
         hookCount = 0;
         return;
     }
+    TRACE_SCOPE(Update, "ComponentContext::update");
     updating = true;
 
 
     _updateStates();
-    for (auto &effect: effects) {
-        if (effect.cleanup->hasValue()) {
-            effect.cleanup->call();
-        }
-        auto &deps = effect.deps;
-        if (deps.empty()) continue;
-        auto needRecall = false;
-        for (auto &dep: deps) {
-            for (auto &pair: updatedStates) {
-                if (states[pair.first].object->equals(dep.get())) {
-                    needRecall = true;
-                }
-            }
+    // Effects below may set state again, that has to leave the component dirty for the next pass.
+    dirty = false;
+    for (const size_t slot: updatedSlots) {
+        if (slot >= stateEffects.size()) continue;
+        for (const size_t index: stateEffects[slot]) {
+            if (effects[index].scheduled) continue;
+            effects[index].scheduled = true;
+            effectsToRun.push_back(index);
         }
-        if (needRecall) {
-            auto result = effect.callback->call();
-            effect.cleanup = std::move(result);
+    }
+    // Effects run in the order they were declared, like they did on mount.
+    std::sort(effectsToRun.begin(), effectsToRun.end());
+    engine->counters().effectsRun += effectsToRun.size();
+    for (const size_t index: effectsToRun) {
+        auto &effect = effects[index];
+        effect.scheduled = false;
+        if (effect.cleanup.hasValue()) {
+            BridgeScope scope(BridgeCall::CallEffectCleanup);
+            effect.cleanup.call();
         }
+        BridgeScope scope(BridgeCall::CallEffect);
+        effect.cleanup = effect.callback.call();
     }
-    updatedStates.clear();
-    dirty = false;
+    effectsToRun.clear();
+    updatedSlots.clear();
     hookCount = 0;
     updating = false;
 }
 
 
-std::shared_ptr<Widget> ComponentContext::reconcileObject(const std::shared_ptr<Widget> &old,
-                                                          std::unique_ptr<WidgetHolder> &newCaller) {
-    auto &subComponent = old->component();
+Widget *ComponentContext::reconcileObject(Widget &old, std::unique_ptr<WidgetHolder> &newCaller) {
+    TRACE_SCOPE(Reconcile, "reconcileObject");
+    auto *subComponent = old.component();
     //bool sameComponent = subComponent.get() == this;
 
 
@@ -125,31 +240,39 @@ std::shared_ptr<Widget> ComponentContext::reconcileObject(const std::shared_ptr<
             auto originalReconcilation = subComponent->_reconciliationStarted;
             subComponent->_reconciliationStarted = true;
             subComponent->_updateStates();
+            engine->updates().markReconciled(*subComponent);
 
-            engine->pushExistingComponent(subComponent);
+            engine->pushExistingComponent(subComponent->shared_from_this());
             auto result = newCaller->execute(engine);
             subComponent->_reconciliationStarted = originalReconcilation;
             return result;
         }
-        //TODO: We need unmounting here
+        // The old component unmounts when the caller releases its root widget.
+        return newCaller->execute(engine);
+    }
+    // Another component's root belongs to that component, reusing it for a plain div or text would keep the component
+    // mounted without its function running again. It's replaced instead and the caller unmounts it.
+    if (subComponent != this && subComponent->rootWidget() == old.handle()) {
         return newCaller->execute(engine);
     }
     auto componentName = newCaller->getComponentName();
-    if (componentName == "div" && old->is<ContainerWidget>()) {
+    if (componentName == "div" && old.is<ContainerWidget>()) {
         subComponent->_reconciliationStarted = true;
-        engine->compareProps(old->propMap, newProps);
+        old.syncStyleObject();
+        old.applyPropDiff(engine->compareProps(old.propMap, newProps));
         auto children = newCaller->getChildren();
-        reconcileWidgetHolders(old->as<ContainerWidget>(), std::move(children));
+        reconcileWidgetHolders(*old.as<ContainerWidget>(), std::move(children));
         subComponent->_reconciliationStarted = false;
-        return old;
+        return &old;
     }
-    if (componentName == "text" && old->is<TextWidget>()) {
+    if (componentName == "text" && old.is<TextWidget>()) {
         //I am pretty sure we need a new way of handling this
-        engine->compareProps(old->propMap, newProps);
+        old.syncStyleObject();
+        old.applyPropDiff(engine->compareProps(old.propMap, newProps));
 
-        const auto textWidget = old->as<TextWidget>();
+        const auto textWidget = old.as<TextWidget>();
         textWidget->replaceChildren(newCaller->getTextChildren());
-        return old;
+        return &old;
     }
     return newCaller->execute(engine);
 }
@@ -158,19 +281,22 @@ std::shared_ptr<Widget> ComponentContext::reconcileObject(const std::shared_ptr<
  * Original reconcileList function that maps array items and a function to widget holders
  * and passes them to the generalized reconciler
  */
-void ComponentContext::reconcileList(const SharedWidget &listHolder,
+void ComponentContext::reconcileList(Widget &listHolder,
                                      std::unique_ptr<AmaraArray> arr,
-                                     std::unique_ptr<StateWrapper> func) {
+                                     StateWrapper func) {
     // Convert array items to widget holders
     std::vector<std::unique_ptr<WidgetHolder> > widgetHolders;
     widgetHolders.reserve(arr->size());
 
     for (int i = 0; i < arr->size(); ++i) {
         const auto val = arr->getValue(i);
-        auto result = func->call(val->getValue(), Value(i));
+        auto result = [&] {
+            BridgeScope scope(BridgeCall::CallListItem);
+            return func.call(val.getValue(), Value(i));
+        }();
 
         // Skip if result is falsy
-        if (!result->hasValue() || (result->getValue().isBool() && !result->getValue().asBool())) {
+        if (!result.hasValue() || (result.getValue().isBool() && !result.getValue().asBool())) {
             continue;
         }
 
@@ -181,144 +307,136 @@ void ComponentContext::reconcileList(const SharedWidget &listHolder,
     }
 
     // Call the generalized reconciliation function
-    reconcileWidgetHolders(listHolder->as<ContainerWidget>(), std::move(widgetHolders));
+    reconcileWidgetHolders(*listHolder.as<ContainerWidget>(), std::move(widgetHolders));
 }
 
 /**
- * Generalized function that reconciles a container with a vector of widget holders
+ * Generalized function that reconciles a container with a vector of widget holders.
+ *
+ * Children are matched by key (unkeyed ones by position), after trimming the common prefix and suffix. Reused
+ * children are reconciled in place, children on the longest increasing run of old positions stay put and the rest
+ * are moves, so the container is rebuilt from one op list in a single pass.
  */
-void ComponentContext::reconcileWidgetHolders(const std::shared_ptr<ContainerWidget> &listHolder,
+void ComponentContext::reconcileWidgetHolders(ContainerWidget &holder,
                                               std::vector<std::unique_ptr<WidgetHolder> > widgetHolders) {
-    auto holder = listHolder->as<ContainerWidget>();
+    TRACE_SCOPE(Reconcile, "reconcileWidgetHolders");
+    widgetHolders.erase(std::remove(widgetHolders.begin(), widgetHolders.end(), nullptr), widgetHolders.end());
+    // A div that rendered conditional children can have empty slots, the list below matches children by position.
+    holder.compactChildren();
 
     // Initial render case
-    if (!holder->hasChildren()) {
+    if (!holder.hasChildren()) {
         for (const auto &widgetHolder: widgetHolders) {
-            if (!widgetHolder) continue;
             auto widget = widgetHolder->execute(engine);
             if (widget) {
-                holder->addChild(widget);
+                holder.addChild(*widget);
+                ++engine->counters().childOps[static_cast<size_t>(ChildOpKind::Insert)];
             }
         }
         return;
     }
 
-    // Reconciliation case
-    auto currentChildren = holder->children();
+    ListReconcileScratchPool::Lease lease(engine->listScratch());
+    auto &scratch = *lease;
+    const size_t oldSize = holder.children().size();
+    const auto oldChild = [&](size_t index) {
+        return holder.childAt(index);
+    };
     const size_t newSize = widgetHolders.size();
 
-    // Build map of existing keyed widgets with their original indices
-    std::unordered_map<std::string, std::pair<SharedWidget, size_t> > existingChildren;
-    for (size_t i = 0; i < currentChildren.size(); ++i) {
-        if (currentChildren[i]->key.hasKey()) {
-            existingChildren[currentChildren[i]->key.key] = {currentChildren[i], i};
-        }
+    auto sameSlot = [&](size_t oldIndex, size_t newIndex) {
+        return oldChild(oldIndex)->key.key == widgetHolders[newIndex]->key().key;
+    };
+    size_t start = 0;
+    while (start < oldSize && start < newSize && sameSlot(start, start)) ++start;
+    size_t oldEnd = oldSize;
+    size_t newEnd = newSize;
+    while (oldEnd > start && newEnd > start && sameSlot(oldEnd - 1, newEnd - 1)) {
+        --oldEnd;
+        --newEnd;
     }
 
-    // Prepare new children list and tracking structures
-    std::vector<SharedWidget> newChildren;
-    newChildren.reserve(newSize);
-    std::unordered_set<std::string> usedKeys;
-    std::vector<std::pair<int, size_t> > oldIndices; // (new index, old index)
-
-    // Process each new widget holder
-    for (int i = 0; i < newSize; ++i) {
-        auto &widgetHolder = widgetHolders[i];
-        if (!widgetHolder) continue;
-
-        auto newKey = widgetHolder->key();
-        SharedWidget widget;
-
-        if ((newKey.hasKey() && existingChildren.count(newKey.key))) {
-            // Reuse existing widget
-            widget = existingChildren[newKey.key].first;
-            widget->component()->_reconciliationStarted = true;
-            widget = this->reconcileObject(widget, widgetHolder);
-            widget->component()->_reconciliationStarted = false;
-            widget->component()->hookCount = 0;
-            usedKeys.insert(newKey.key);
-            oldIndices.emplace_back(i, existingChildren[newKey.key].second);
-        } else if (!newKey.hasKey() && i < currentChildren.size() && !currentChildren[i]->key.hasKey()) {
-            widget = currentChildren[i];
-            widget->component()->_reconciliationStarted = true;
-            widget = this->reconcileObject(widget, widgetHolder);
-            widget->component()->_reconciliationStarted = false;
-            widget->component()->hookCount = 0;
-            oldIndices.emplace_back(i, i);
-        } else {
-            // Create new widget
-            widget = widgetHolder->execute(engine);
-            if (newKey.hasKey()) {
-                oldIndices.emplace_back(i, -1); // New widget, no old index
-            }
+    // Match the middle range: keyed children by key, unkeyed ones with the unkeyed old child at the same index.
+    KeyIndex keyedOld(scratch.keySlots, oldEnd - start, [&](size_t index) -> std::string_view {
+        return oldChild(index)->key.key;
+    });
+    for (size_t i = start; i < oldEnd; ++i) {
+        const auto &key = oldChild(i)->key;
+        if (key.hasKey()) keyedOld.insert(key.key, i);
+    }
+    scratch.oldUsed.assign(oldSize, false);
+    scratch.sources.assign(newEnd - start, NO_SOURCE);
+    for (size_t i = start; i < newEnd; ++i) {
+        const auto &key = widgetHolders[i]->key();
+        size_t source = NO_SOURCE;
+        if (key.hasKey()) {
+            source = keyedOld.find(key.key);
+        } else if (i < oldEnd && !oldChild(i)->key.hasKey()) {
+            source = i;
         }
-
-        if (widget) {
-            newChildren.push_back(widget);
+        // A duplicated key only reuses the first old child.
+        if (source != NO_SOURCE && !scratch.oldUsed[source]) {
+            scratch.sources[i - start] = source;
+            scratch.oldUsed[source] = true;
         }
     }
-
-    // Compute Longest Increasing Subsequence to find widgets that maintain relative order
-    std::vector<int> lis;
-    if (!oldIndices.empty()) {
-        for (auto &p: oldIndices) {
-            auto it = std::lower_bound(lis.begin(), lis.end(), p.second);
-            if (it == lis.end()) {
-                lis.push_back(p.second);
-            } else {
-                *it = p.second;
-            }
+    for (size_t i = 0; i < start; ++i) scratch.oldUsed[i] = true;
+    for (size_t i = oldEnd; i < oldSize; ++i) scratch.oldUsed[i] = true;
+
+    // Reconcile reused children and create the rest, in the new order.
+    scratch.ops.clear();
+    scratch.inserted.clear();
+    for (size_t i = 0; i < newSize; ++i) {
+        size_t source;
+        if (i < start) {
+            source = i;
+        } else if (i >= newEnd) {
+            source = oldEnd + (i - newEnd);
+        } else {
+            source = scratch.sources[i - start];
         }
-    }
-
-    // Apply minimal updates to container
-    std::vector<SharedWidget> tempChildren = currentChildren;
-    size_t currentIdx = 0, newIdx = 0;
 
-    while (newIdx < newChildren.size()) {
-        bool isInLIS = std::find(lis.begin(), lis.end(), newIdx) != lis.end();
-
-        if (currentIdx < tempChildren.size() && isInLIS &&
-            tempChildren[currentIdx] == newChildren[newIdx]) {
-            // Widget is in LIS and at correct position - keep it
-            ++currentIdx;
-            ++newIdx;
-        } else {
-            // Widget needs to be inserted or moved
-            bool found = false;
-            for (size_t j = currentIdx; j < tempChildren.size(); ++j) {
-                if (tempChildren[j] == newChildren[newIdx]) {
-                    // Move existing widget to the right position
-                    holder->replaceChild(j, newChildren[newIdx]);
-                    tempChildren.erase(tempChildren.begin() + j);
-                    tempChildren.insert(tempChildren.begin() + newIdx, newChildren[newIdx]);
-                    found = true;
-                    break;
-                }
+        if (source != NO_SOURCE) {
+            auto *old = oldChild(source);
+            const auto component = old->component();
+            component->_reconciliationStarted = true;
+            auto widget = this->reconcileObject(*old, widgetHolders[i]);
+            component->_reconciliationStarted = false;
+            component->hookCount = 0;
+            if (widget == old) {
+                scratch.ops.push_back({ChildOpKind::Keep, source});
+                continue;
             }
-
-            if (!found) {
-                // Insert new widget
-                holder->insertChild(newIdx, newChildren[newIdx]);
-                tempChildren.insert(tempChildren.begin() + newIdx, newChildren[newIdx]);
+            // Replaced by a different widget, the old one goes away.
+            scratch.oldUsed[source] = false;
+            if (i >= start && i < newEnd) scratch.sources[i - start] = NO_SOURCE;
+            if (widget) {
+                scratch.ops.push_back({ChildOpKind::Insert, scratch.inserted.size()});
+                scratch.inserted.push_back(widget);
             }
-            ++currentIdx;
-            ++newIdx;
+            continue;
+        }
+        auto widget = widgetHolders[i]->execute(engine);
+        if (widget) {
+            scratch.ops.push_back({ChildOpKind::Insert, scratch.inserted.size()});
+            scratch.inserted.push_back(widget);
         }
     }
 
-    // Remove any remaining children not in new list
-    while (currentIdx < tempChildren.size()) {
-        holder->removeChild(currentIdx);
-        tempChildren.erase(tempChildren.begin() + currentIdx);
+    // Reused middle children off the longest increasing run of old positions have to move.
+    markLongestIncreasing(scratch.sources, scratch.stable, scratch.lisTails, scratch.lisPrevious);
+    scratch.oldStable.assign(oldSize, false);
+    for (size_t i = 0; i < scratch.sources.size(); ++i) {
+        if (scratch.stable[i]) scratch.oldStable[scratch.sources[i]] = true;
     }
-
-    // Destroy unused widgets
-    for (const auto &[key, widgetPair]: existingChildren) {
-        if (usedKeys.find(key) == usedKeys.end()) {
-            if (widgetPair.first) {
-                widgetPair.first->resetPointer();
-            }
-        }
+    for (auto &op: scratch.ops) {
+        if (op.kind != ChildOpKind::Keep || op.index < start || op.index >= oldEnd) continue;
+        if (!scratch.oldStable[op.index]) op.kind = ChildOpKind::Move;
     }
+    for (size_t i = 0; i < oldSize; ++i) {
+        if (!scratch.oldUsed[i]) scratch.ops.push_back({ChildOpKind::Remove, i});
+    }
+
+    engine->counters().recordChildOps(scratch.ops);
+    holder.applyChildOps(scratch.ops, scratch.inserted);
 }
@@ -1,25 +1,28 @@
 #ifndef COMPONENTCONTEXT_H
 #define COMPONENTCONTEXT_H
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
 #include "../runtime/hermes/StateWrapper.h"
 #include "../runtime/WidgetHolder.h"
 #include "../runtime/AmaraArray.h"
+#include "WidgetHandle.h"
 class ContainerWidget;
 class Widget;
 using EffectCleanup = std::optional<std::function<void()> >;
 using EffectCallback = std::function<EffectCleanup()>;
-using SetStateFunction = std::function<void(StateWrapperRef)>;
+using SetStateFunction = std::function<void(StateWrapper)>;
 using EmptyFunction = std::function<void()>;
 class IEngine;
 class Widget;
 
 static size_t currentIndex = 0;
 
-class ComponentContext {
+class ComponentContext : public std::enable_shared_from_this<ComponentContext> {
 private:
     bool _reconciliationStarted = false;
     bool insideReconciliation = false;
@@ -28,50 +31,127 @@ private:
     bool updating;
 
     struct Effect {
-        StateWrapperRef callback;
-        std::vector<StateWrapperRef> deps;
+        StateWrapper callback;
+        StateWrapper cleanup;
+        // Set while the effect is collected for a re-run, so an effect depending on several changed states runs once.
+        bool scheduled = false;
 
-        StateWrapperRef cleanup;
-
-        Effect(StateWrapperRef callback, std::vector<StateWrapperRef> deps,
-               StateWrapperRef cleanup)
+        Effect(StateWrapper callback, StateWrapper cleanup)
             : callback(std::move(callback)),
-              deps(std::move(deps)),
               cleanup(std::move(cleanup)) {
         }
     };
 
     struct State {
-        StateWrapperRef object;
-        std::vector<std::unique_ptr<StateWrapper> > pendingUpdates;
+        StateWrapper object;
+        // Value queued by setState for the next update, empty if there is none.
+        StateWrapper pending;
     };
 
     void _updateStates();
 
+    void indexEffectDep(size_t slot, size_t effectIndex);
+
     bool dirty = false;
-    //widgets inside the component
 
-    std::vector<Effect> effects;
-    std::vector<State> states;
-    std::unordered_map<size_t, StateWrapperRef> toBeUpdated;
-    std::unordered_map<size_t, StateWrapperRef> updatedStates;
+    // Backs the hook states, effect records and scratch vectors below, releaseHooks hands it back in one go. Widgets
+    // aren't in it, they live in the engine's WidgetPool slabs that widget handles index.
+    std::pmr::unsynchronized_pool_resource hookArena;
+    std::pmr::vector<Effect> effects{&hookArena};
+    std::pmr::vector<State> states{&hookArena};
+    // Reverse index from a state slot to the effects listing it as a dependency, built when effects register.
+    std::pmr::vector<std::pmr::vector<size_t> > stateEffects{&hookArena};
+    struct UnresolvedDep {
+        size_t effect;
+        StateWrapper dep;
+    };
+
+    // Deps that matched no state when their effect registered, checked against every state created afterwards.
+    std::pmr::vector<UnresolvedDep> unresolvedDeps{&hookArena};
+    // Scratch for the effects re-run by one update.
+    std::pmr::vector<size_t> effectsToRun{&hookArena};
+    // Slots with a pending value, and the slots the current update applied. Kept around so updates don't allocate.
+    std::pmr::vector<size_t> pendingSlots{&hookArena};
+    std::pmr::vector<size_t> updatedSlots{&hookArena};
     size_t _index;
+    // Distance from the root component, the scheduler runs shallower components first.
+    size_t _depth;
+
+    // Intrusive UpdateScheduler state.
+    friend class UpdateScheduler;
+    bool _queued = false;
+    uint64_t _scheduledAt = 0;
+    uint64_t _reconciledAt = 0;
+    bool _unmounted = false;
+
+    // Widgets created while this component ran, owned here until they are released. The list is intrusive, each
+    // widget owns the next one and knows the previous one, so releasing a widget is an unlink, not a search.
+    std::shared_ptr<Widget> firstWidget;
+    size_t _widgetCount = 0;
+    // The widget the component function returned last, releasing it unmounts the component.
+    WidgetHandle _rootWidget;
+    // Position in the engine's mounted components, see IEngine::adoptComponent.
+    friend class IEngine;
+    static constexpr size_t NOT_MOUNTED = SIZE_MAX;
+    size_t mountedIndex = NOT_MOUNTED;
+    // Child slots the JSX transform gave the component function, the slot tables of its widgets are sized to it.
+    size_t _slotCount = 0;
+
+    // Drops a queued update whose states a parent already applied while re-executing this component.
+    void discardUpdate();
 
 public:
-    explicit ComponentContext(IEngine *engine): engine(engine), _index(currentIndex++) {
+    explicit ComponentContext(IEngine *engine, size_t depth = 0): engine(engine), _index(currentIndex++),
+                                                                  _depth(depth) {
+    }
+
+    void addWidget(const std::shared_ptr<Widget> &widget);
+
+    // Takes the widget out of this component, returns the component's reference so the caller decides when it dies.
+    std::shared_ptr<Widget> releaseWidget(Widget &widget);
+
+    size_t widgetCount() const {
+        return _widgetCount;
+    }
+
+    void setRootWidget(WidgetHandle root) {
+        _rootWidget = root;
+    }
+
+    WidgetHandle rootWidget() const {
+        return _rootWidget;
     }
 
-    std::vector<std::shared_ptr<Widget> > widgets;
+    void reserveSlots(size_t count) {
+        _slotCount = count;
+    }
+
+    size_t slotCount() const {
+        return _slotCount;
+    }
+
+    /**
+     * Runs the effect cleanups. Called when the root widget is unmounted, the ReclaimQueue frees the rest later.
+     * Queued updates and late setState calls of an unmounted component are ignored.
+     */
+    void unmount();
+
+    // Queues the widgets the component still owns, each leaves the component when it is reset.
+    void releaseWidgets(std::vector<WidgetHandle> &out);
+
+    // Drops hook states and effects, the JS values they hold go with them, then releases the hook arena.
+    void releaseHooks();
 
-    std::tuple<StateWrapper *, SetStateFunction> useState(StateWrapperRef value, EmptyFunction notifier);
+    bool unmounted() const {
+        return _unmounted;
+    }
 
-    void effect(StateWrapperRef fn, std::vector<StateWrapperRef> deps);
+    std::tuple<Value, SetStateFunction> useState(StateWrapper value, EmptyFunction notifier);
 
-    void reconcileChildren(std::shared_ptr<ContainerWidget> &shared,
-                           std::shared_ptr<ContainerWidget> &container_widget);
+    void effect(StateWrapper fn, std::vector<StateWrapper> deps);
 
-    std::shared_ptr<Widget> reconcileObject(const std::shared_ptr<Widget> &old,
-                                            std::unique_ptr<WidgetHolder> &newCaller);
+    // Returns `old` if it was updated in place, otherwise the new widget.
+    Widget *reconcileObject(Widget &old, std::unique_ptr<WidgetHolder> &newCaller);
 
     void update();
 
@@ -79,27 +159,32 @@ public:
         return _reconciliationStarted;
     }
 
-    void reconcileList(const std::shared_ptr<Widget> &listHolder, std::unique_ptr<AmaraArray> arr,
-                       std::unique_ptr<StateWrapper> func);
+    void reconcileList(Widget &listHolder, std::unique_ptr<AmaraArray> arr,
+                       StateWrapper func);
 
-    void reconcileWidgetHolders(const std::shared_ptr<ContainerWidget> &listHolder,
+    void reconcileWidgetHolders(ContainerWidget &holder,
                                 std::vector<std::unique_ptr<WidgetHolder> > widgetHolders);
 
     void markDirty() {
         dirty = true;
     };
 
-    std::weak_ptr<ContainerWidget> reconcilingObject;
-    StateWrapperRef componentObject;
+    WidgetHandle reconcilingObject;
+    StateWrapper componentObject;
 
-    ~ComponentContext() {
-        widgets.clear();
-        int x = 0;
-    }
+    ~ComponentContext();
 
     size_t index() {
         return _index;
     }
+
+    size_t depth() const {
+        return _depth;
+    }
+
+    IEngine *getEngine() const {
+        return engine;
+    }
 };
 
 
@@ -0,0 +1,22 @@
+#include "FrameStats.h"
+
+void writeFrameStatsJson(std::ostream &out, const FrameStats &stats) {
+    out << "{\"frame\":" << stats.frame
+            << ",\"durationMs\":" << stats.durationMs
+            << ",\"componentsUpdated\":" << stats.componentsUpdated
+            << ",\"effectsRun\":" << stats.effectsRun
+            << ",\"widgetsCreated\":" << stats.widgetsCreated
+            << ",\"widgetsReused\":" << stats.widgetsReused
+            << ",\"widgetsFreed\":" << stats.widgetsFreed
+            << ",\"bytesReclaimed\":" << stats.bytesReclaimed
+            << ",\"widgetsUnmounted\":" << stats.widgetsUnmounted
+            << ",\"reclaimBacklog\":" << stats.reclaimBacklog
+            << ",\"childOps\":{\"keep\":" << stats.childOps[static_cast<size_t>(ChildOpKind::Keep)]
+            << ",\"move\":" << stats.childOps[static_cast<size_t>(ChildOpKind::Move)]
+            << ",\"insert\":" << stats.childOps[static_cast<size_t>(ChildOpKind::Insert)]
+            << ",\"remove\":" << stats.childOps[static_cast<size_t>(ChildOpKind::Remove)]
+            << "},\"jsiCalls\":" << stats.jsiCalls
+            << ",\"gcCollections\":" << stats.gcCollections
+            << ",\"gcPauseMs\":" << stats.gcPauseMs
+            << "}\n";
+}
@@ -0,0 +1,56 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "ListReconciler.h"
+
+constexpr size_t CHILD_OP_KIND_COUNT = static_cast<size_t>(ChildOpKind::Remove) + 1;
+
+// Running totals the engine bumps as it works, FrameStats holds their difference over one frame.
+struct EngineCounters {
+    size_t effectsRun = 0;
+    std::array<size_t, CHILD_OP_KIND_COUNT> childOps{};
+
+    void recordChildOps(const std::vector<ChildOp> &ops) {
+        for (const auto &op: ops) {
+            ++childOps[static_cast<size_t>(op.kind)];
+        }
+    }
+};
+
+// Collector totals of the JS engine, whatever the engine exposes.
+struct GcStats {
+    uint64_t collections = 0;
+    double pauseMs = 0;
+};
+
+struct FrameStats {
+    uint64_t frame = 0;
+    double durationMs = 0;
+    size_t componentsUpdated = 0;
+    size_t effectsRun = 0;
+    // Widget slots newly carved, taken from a free list and handed back to the WidgetPool.
+    size_t widgetsCreated = 0;
+    size_t widgetsReused = 0;
+    size_t widgetsFreed = 0;
+    // Widget pool memory given back by trimming.
+    size_t bytesReclaimed = 0;
+    // Unmounted widgets freed this frame, and the ones still waiting.
+    size_t widgetsUnmounted = 0;
+    size_t reclaimBacklog = 0;
+    // Indexed by ChildOpKind.
+    std::array<size_t, CHILD_OP_KIND_COUNT> childOps{};
+    // Only counted while BridgeStats records.
+    uint64_t jsiCalls = 0;
+    // Only collected while a frame stats sink is set or setCollectGcStats asked for them.
+    uint64_t gcCollections = 0;
+    double gcPauseMs = 0;
+};
+
+// One JSON object per line, the format the dashboards ingest.
+void writeFrameStatsJson(std::ostream &out, const FrameStats &stats);
+
+#endif //FRAMESTATS_H
@@ -0,0 +1,34 @@
+#include "ListReconciler.h"
+
+void markLongestIncreasing(const std::vector<size_t> &sources, std::vector<bool> &stable,
+                           std::vector<size_t> &tails, std::vector<size_t> &previous) {
+    const size_t count = sources.size();
+    stable.assign(count, false);
+    previous.assign(count, NO_SOURCE);
+    // tails[k] is the index of the smallest source ending an increasing run of length k + 1.
+    tails.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t source = sources[i];
+        if (source == NO_SOURCE) continue;
+        size_t low = 0;
+        size_t high = tails.size();
+        while (low < high) {
+            const size_t middle = (low + high) / 2;
+            if (sources[tails[middle]] < source) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (low > 0) previous[i] = tails[low - 1];
+        if (low == tails.size()) {
+            tails.push_back(i);
+        } else {
+            tails[low] = i;
+        }
+    }
+    if (tails.empty()) return;
+    for (size_t i = tails.back(); i != NO_SOURCE; i = previous[i]) {
+        stable[i] = true;
+    }
+}
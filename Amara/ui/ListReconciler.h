@@ -0,0 +1,135 @@
+#ifndef LISTRECONCILER_H
+#define LISTRECONCILER_H
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <functional>
+#include <vector>
+
+class Widget;
+
+enum class ChildOpKind : unsigned char {
+    // The old child stays where it is relative to the other kept children.
+    Keep,
+    // The old child is reused at a new position.
+    Move,
+    // A newly created child, taken from the inserted list.
+    Insert,
+    // The old child isn't part of the new list and gets destroyed.
+    Remove
+};
+
+struct ChildOp {
+    ChildOpKind kind;
+    // Old child index for Keep/Move/Remove, index into the inserted widgets for Insert.
+    size_t index;
+};
+
+constexpr size_t NO_SOURCE = SIZE_MAX;
+
+/**
+ * Buffers one keyed list reconciliation works in. They're kept between passes so reconciling a list that didn't
+ * grow doesn't allocate.
+ */
+struct ListReconcileScratch {
+    // Key -> old index for the old children between the common prefix and suffix, see KeyIndex.
+    std::vector<size_t> keySlots;
+    // Old index each new child of that middle range comes from, NO_SOURCE for new ones.
+    std::vector<size_t> sources;
+    std::vector<bool> oldUsed;
+    std::vector<bool> stable;
+    // Same as `stable`, indexed by old position.
+    std::vector<bool> oldStable;
+    std::vector<size_t> lisTails;
+    std::vector<size_t> lisPrevious;
+    std::vector<Widget *> inserted;
+    // One Keep/Move/Insert per new child in order, followed by the Removes.
+    std::vector<ChildOp> ops;
+};
+
+/**
+ * Open addressing key -> old index table over ListReconcileScratch::keySlots. Slots hold the old index + 1 and the
+ * keys are read back from the children, so filling it doesn't allocate once the buffer is big enough.
+ */
+template<typename KeyAt>
+class KeyIndex {
+public:
+    KeyIndex(std::vector<size_t> &slots, size_t count, KeyAt keyAt) : slots(slots), keyAt(keyAt) {
+        size_t capacity = 16;
+        while (capacity < count * 2) capacity *= 2;
+        slots.assign(capacity, 0);
+        mask = capacity - 1;
+    }
+
+    // Keeps the first index for a duplicated key.
+    void insert(std::string_view key, size_t index) {
+        for (size_t slot = hash(key);; slot = (slot + 1) & mask) {
+            if (slots[slot] == 0) {
+                slots[slot] = index + 1;
+                return;
+            }
+            if (keyAt(slots[slot] - 1) == key) return;
+        }
+    }
+
+    size_t find(std::string_view key) const {
+        for (size_t slot = hash(key);; slot = (slot + 1) & mask) {
+            if (slots[slot] == 0) return NO_SOURCE;
+            if (keyAt(slots[slot] - 1) == key) return slots[slot] - 1;
+        }
+    }
+
+private:
+    size_t hash(std::string_view key) const {
+        return std::hash<std::string_view>{}(key) & mask;
+    }
+
+    std::vector<size_t> &slots;
+    KeyAt keyAt;
+    size_t mask;
+};
+
+/**
+ * Reconciling a child can reconcile its own lists, so scratch buffers are handed out per nesting level.
+ */
+class ListReconcileScratchPool {
+public:
+    class Lease {
+    public:
+        explicit Lease(ListReconcileScratchPool &pool) : pool(pool), scratch(pool.push()) {
+        }
+
+        Lease(const Lease &) = delete;
+
+        ~Lease() {
+            scratch.inserted.clear();
+            --pool.depth;
+        }
+
+        ListReconcileScratch &operator*() const {
+            return scratch;
+        }
+
+    private:
+        ListReconcileScratchPool &pool;
+        ListReconcileScratch &scratch;
+    };
+
+private:
+    ListReconcileScratch &push() {
+        if (depth == levels.size()) levels.push_back(std::make_unique<ListReconcileScratch>());
+        return *levels[depth++];
+    }
+
+    std::vector<std::unique_ptr<ListReconcileScratch> > levels;
+    size_t depth = 0;
+};
+
+/**
+ * Sets `stable[i]` for the entries of `sources` that form a longest increasing subsequence, skipping NO_SOURCE.
+ * Those children keep their relative order, every other reused child is a move. O(n log n).
+ */
+void markLongestIncreasing(const std::vector<size_t> &sources, std::vector<bool> &stable,
+                           std::vector<size_t> &tails, std::vector<size_t> &previous);
+
+#endif //LISTRECONCILER_H
@@ -0,0 +1,82 @@
+#include "ReclaimQueue.h"
+
+#include "ComponentContext.h"
+#include "Widget.h"
+#include "../runtime/IEngine.h"
+#include "../utils/Trace.h"
+#include "../utils/WidgetPool.h"
+
+void ReclaimQueue::unmount(Widget &widget) {
+    TRACE_SCOPE(Reconcile, "unmount");
+    widget.clearParent();
+    // Pre-order, so a component's cleanups run before the ones of the components it rendered.
+    walk.clear();
+    walk.push_back(&widget);
+    while (!walk.empty()) {
+        auto *node = walk.back();
+        walk.pop_back();
+        auto *component = node->component();
+        if (component && !component->unmounted() && component->rootWidget() == node->handle()) {
+            component->getEngine()->unmountComponent(*component);
+        }
+        for (size_t i = node->layoutChildCount(); i > 0; --i) {
+            if (!node->ownsLayoutChild(i - 1)) continue;
+            if (auto *child = node->layoutChildAt(i - 1)) walk.push_back(child);
+        }
+    }
+    pending.push_back(widget.handle());
+}
+
+bool ReclaimQueue::freeOne() {
+    if (!pending.empty()) {
+        auto *widget = pool.resolve(pending.back());
+        pending.pop_back();
+        if (!widget) return false;
+        // Children are queued instead of reset recursively, so a big subtree is spread over several drains.
+        widget->releaseChildren(pending);
+        widget->resetPointer();
+        return true;
+    }
+    if (!components.empty()) {
+        auto component = std::move(components.back());
+        components.pop_back();
+        if (component->widgetCount() != 0) {
+            // Its widgets point at it, so it waits for them behind the queued widgets and comes back here once they
+            // are freed.
+            component->releaseWidgets(pending);
+            components.push_back(std::move(component));
+            return false;
+        }
+        component->releaseHooks();
+    }
+    return false;
+}
+
+size_t ReclaimQueue::drain(FrameClock::duration budget) {
+    if (empty()) return 0;
+    TRACE_SCOPE(Frame, "reclaim");
+    const auto deadline = FrameClock::now() + budget;
+    size_t freed = 0;
+    size_t sinceCheck = 0;
+    while (!empty()) {
+        if (freeOne()) ++freed;
+        if (++sinceCheck == CHECK_INTERVAL) {
+            sinceCheck = 0;
+            if (FrameClock::now() >= deadline) break;
+        }
+    }
+    return freed;
+}
+
+size_t ReclaimQueue::drainAll() {
+    size_t freed = 0;
+    while (!empty()) {
+        if (freeOne()) ++freed;
+    }
+    return freed;
+}
+
+void ReclaimQueue::clear() {
+    pending.clear();
+    components.clear();
+}
@@ -0,0 +1,66 @@
+#ifndef RECLAIMQUEUE_H
+#define RECLAIMQUEUE_H
+
+#include <memory>
+#include <vector>
+
+#include "UpdateScheduler.h"
+#include "WidgetHandle.h"
+
+class Widget;
+class ComponentContext;
+class WidgetPool;
+
+/**
+ * Unmounted widgets waiting to be freed. Unmounting a subtree runs the effect cleanups of its components and
+ * detaches it right away, resetting the widgets (props, styles, the JS values they hold) and handing their slots back
+ * to the pool happens here, a bounded amount per frame.
+ */
+class ReclaimQueue {
+public:
+    // Widgets freed between two clock reads while draining.
+    static constexpr size_t CHECK_INTERVAL = 32;
+
+    explicit ReclaimQueue(const WidgetPool &pool) : pool(pool) {
+    }
+
+    // Runs the cleanups of every component rooted in the subtree, parents before children, and queues the subtree.
+    void unmount(Widget &widget);
+
+    // An unmounted component, its hooks and the widgets it owns outside the unmounted subtree are freed once the
+    // queued widgets are.
+    void push(std::shared_ptr<ComponentContext> component) {
+        components.push_back(std::move(component));
+    }
+
+    /**
+     * Frees queued widgets, and the hooks of unmounted components once their widgets are gone, until the queue is
+     * empty or `budget` is used up. At least CHECK_INTERVAL widgets are freed per call. Returns the widgets freed.
+     */
+    size_t drain(FrameClock::duration budget);
+
+    size_t drainAll();
+
+    // Drops everything without resetting it, for engine teardown once the pool is finished.
+    void clear();
+
+    [[nodiscard]] bool empty() const {
+        return pending.empty() && components.empty();
+    }
+
+    size_t size() const {
+        return pending.size() + components.size();
+    }
+
+private:
+    bool freeOne();
+
+    const WidgetPool &pool;
+    // Handles, a widget queued twice (a subtree and the component owning it) is freed once.
+    std::vector<WidgetHandle> pending;
+    std::vector<std::shared_ptr<ComponentContext> > components;
+    // Scratch for unmount().
+    std::vector<Widget *> walk;
+};
+
+#endif //RECLAIMQUEUE_H
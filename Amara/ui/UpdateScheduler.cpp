@@ -0,0 +1,72 @@
+#include "UpdateScheduler.h"
+
+#include "ComponentContext.h"
+
+void UpdateScheduler::schedule(const std::shared_ptr<ComponentContext> &component) {
+    component->_scheduledAt = ++sequence;
+    if (component->_queued) return;
+    component->_queued = true;
+
+    const size_t depth = component->depth();
+    if (depth >= buckets.size()) buckets.resize(depth + 1);
+    buckets[depth].push_back(component);
+    ++pendingCount;
+}
+
+void UpdateScheduler::markReconciled(ComponentContext &component) {
+    component._reconciledAt = ++sequence;
+}
+
+FrameResult UpdateScheduler::runFrame(FrameClock::duration budget) {
+    FrameResult result;
+    const auto deadline = FrameClock::now() + budget;
+
+    while (pendingCount != 0 && result.passes < MAX_PASSES_PER_FRAME && !result.budgetExceeded) {
+        ++result.passes;
+        // Children scheduled by a parent land in a deeper bucket and run in this pass, anything scheduled at the same
+        // depth or above waits for the next one.
+        for (size_t depth = 0; depth < buckets.size() && !result.budgetExceeded; ++depth) {
+            if (buckets[depth].empty()) continue;
+            running.swap(buckets[depth]);
+            pendingCount -= running.size();
+
+            size_t i = 0;
+            while (i < running.size()) {
+                auto &component = *running[i++];
+                component._queued = false;
+                if (component._unmounted) continue;
+                if (component._reconciledAt > component._scheduledAt) {
+                    component.discardUpdate();
+                    ++result.skipped;
+                    continue;
+                }
+                component.update();
+                ++result.updated;
+                if (FrameClock::now() >= deadline) {
+                    result.budgetExceeded = true;
+                    break;
+                }
+            }
+            // Components the budget didn't reach go back to their bucket, still flagged as queued.
+            for (; i < running.size(); ++i) {
+                buckets[depth].push_back(std::move(running[i]));
+                ++pendingCount;
+            }
+            running.clear();
+        }
+    }
+
+    result.deferred = pendingCount;
+    return result;
+}
+
+void UpdateScheduler::clear() {
+    for (auto &bucket: buckets) {
+        for (auto &component: bucket) {
+            component->_queued = false;
+        }
+        bucket.clear();
+    }
+    running.clear();
+    pendingCount = 0;
+}
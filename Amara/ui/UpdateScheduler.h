@@ -0,0 +1,74 @@
+#ifndef UPDATESCHEDULER_H
+#define UPDATESCHEDULER_H
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ComponentContext;
+
+using FrameClock = std::chrono::steady_clock;
+
+// Half of a 60hz frame, the rest is left for layout and paint.
+constexpr FrameClock::duration DEFAULT_FRAME_BUDGET = std::chrono::milliseconds(8);
+// Taken from what the frame budget leaves for layout and paint to free unmounted widgets.
+constexpr FrameClock::duration DEFAULT_RECLAIM_BUDGET = std::chrono::milliseconds(1);
+
+struct FrameResult {
+    // update() calls made in this frame.
+    size_t updated = 0;
+    // Cascades run, a pass picks up whatever the previous one scheduled.
+    size_t passes = 0;
+    // Queued components a parent already re-executed this frame, their update() was skipped.
+    size_t skipped = 0;
+    // Components still waiting when the frame ended, they run first next frame.
+    size_t deferred = 0;
+    bool budgetExceeded = false;
+    // Something changed since the last frame and the tree was laid out again.
+    bool laidOut = false;
+    // Unmounted widgets freed after layout.
+    size_t reclaimed = 0;
+};
+
+/**
+ * Collects components whose state changed and updates them frame by frame. setState calls between two frames are
+ * coalesced into one update per component, cascades (effects setting state) run in the same frame as long as the
+ * budget allows and whatever doesn't fit is carried over to the next frame. Nothing scheduled is ever dropped.
+ *
+ * The queue is intrusive: a component carries its own queued flag and sits in the bucket of its tree depth, so
+ * scheduling is O(1) without duplicates and every pass runs parents before their children. A child re-executed by
+ * its parent after it was queued is already up to date and isn't updated again.
+ */
+class UpdateScheduler {
+public:
+    // Upper bound on cascades in one frame so a component that keeps setting state can't starve the frame.
+    static constexpr size_t MAX_PASSES_PER_FRAME = 16;
+
+    void schedule(const std::shared_ptr<ComponentContext> &component);
+
+    // Called when a parent re-executes the component, which applies its pending states.
+    void markReconciled(ComponentContext &component);
+
+    [[nodiscard]] bool hasPendingWork() const {
+        return pendingCount != 0;
+    }
+
+    /**
+     * Runs pending updates until there are none left, the budget is used up or MAX_PASSES_PER_FRAME cascades ran.
+     * The budget is checked between components, so at least one component is updated per frame.
+     */
+    FrameResult runFrame(FrameClock::duration budget = DEFAULT_FRAME_BUDGET);
+
+    void clear();
+
+private:
+    // Orders schedule and reconcile events, a component is skipped if it was reconciled after it was last scheduled.
+    uint64_t sequence = 0;
+    size_t pendingCount = 0;
+    // One bucket per tree depth.
+    std::vector<std::vector<std::shared_ptr<ComponentContext> > > buckets;
+    // Scratch for the bucket being run, kept around so frames don't allocate.
+    std::vector<std::shared_ptr<ComponentContext> > running;
+};
+
+#endif //UPDATESCHEDULER_H
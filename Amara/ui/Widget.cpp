@@ -1,5 +1,8 @@
 #include "Widget.h"
 
+#include <algorithm>
+
+#include "../runtime/IEngine.h"
 #include "../runtime/hermes/HermesWidgetHolder.h"
 #include "../utils/ScopedTimer.h"
 #include "../utils/css/CssUtils.h"
@@ -7,281 +10,369 @@
 
 void Widget::parseProps() {
     //TODO REF
-    if (propMap->has("ref")) {
+    if (propMap->has(PropKey::Ref)) {
         //TODO
-        auto ref = propMap->getObject("ref");
-    }
-    if (propMap->has("style")) {
-        this->style = std::move(propMap->getObject("style"));
-        //  parseStyle();
+        auto ref = propMap->getObject(PropKey::Ref);
     }
+    style = propMap->getObject(PropKey::Style);
+    parseStyle();
+}
+
+void Widget::applyPropDiff(const PropDiff &diff) {
+    if (!diff.touches("style")) return;
+    // Nested style changes are written into the same style object, so only the handle of a replaced style changes.
+    style = propMap->getObject(PropKey::Style);
+    parseStyle();
 }
 
 void Widget::parseStyle() {
     //ScopedTimer timer;
-    if (style->has("display")) {
-        widgetStyle.display = parseDisplay(style->getString("display"));
-    }
-    if (style->has("width")) {
-        auto width = style->getString("width");
-        widgetStyle.width = parseCSSValue(width);
-    }
-    if (style->has("height")) {
-        auto height = style->getString("height");
-        widgetStyle.height = parseCSSValue(height);
-    }
-    if (style->has("margin")) {
-        auto values = parseMarginOrPadding(style->getString("margin"));
-        auto &margin = widgetStyle.margin;
-        margin.top = values.top;
-        margin.right = values.right;
-        margin.bottom = values.bottom;
-        margin.left = values.left;
+    auto &cache = _component->getEngine()->styles();
+    ownStyle.reset();
+    _styleDirty = STYLE_ALL_DIRTY;
+    if (!style) {
+        sharedStyle = cache.defaultStyle();
+    } else {
+        auto builder = cache.builder();
+        style->forEachEntry([&builder](const PropMap::Entry &entry) {
+            if (entry.isNumber) {
+                builder.add(entry.key, entry.number);
+            } else {
+                builder.add(entry.key, entry.text);
+            }
+        });
+        sharedStyle = builder.build();
     }
+    applyLayoutStyle();
+}
 
-    // Individual margin properties (override shorthand)
-    if (style->has("marginTop"))
-        widgetStyle.margin.top = parseCSSValue(style->getString("marginTop"));
-    if (style->has("marginRight"))
-        widgetStyle.margin.right = parseCSSValue(style->getString("marginRight"));
-    if (style->has("marginBottom"))
-        widgetStyle.margin.bottom = parseCSSValue(style->getString("marginBottom"));
-    if (style->has("marginLeft"))
-        widgetStyle.margin.left = parseCSSValue(style->getString("marginLeft"));
-
-    // Padding handling
-    if (style->has("padding")) {
-        auto values = parseMarginOrPadding(style->getString("padding"));
-        auto &padding = widgetStyle.padding;
-        padding.top = values.top;
-        padding.right = values.right;
-        padding.bottom = values.bottom;
-        padding.left = values.left;
+namespace {
+    // Only px borders can be folded into the padding, a percent padding keeps its own value.
+    void addBorder(CSSValue &padding, const CSSValue &border) {
+        if (border.unit != CSSUnit::PX) return;
+        if (padding.isUndefined()) {
+            padding = border;
+        } else if (padding.unit == CSSUnit::PX) {
+            padding.value += border.value;
+        }
     }
+}
 
-    // Individual padding properties (override shorthand)
-    if (style->has("paddingTop"))
-        widgetStyle.padding.top = parseCSSValue(style->getString("paddingTop"));
-    if (style->has("paddingRight"))
-        widgetStyle.padding.right = parseCSSValue(style->getString("paddingRight"));
-    if (style->has("paddingBottom"))
-        widgetStyle.padding.bottom = parseCSSValue(style->getString("paddingBottom"));
-    if (style->has("paddingLeft"))
-        widgetStyle.padding.left = parseCSSValue(style->getString("paddingLeft"));
-
-    auto &border = widgetStyle.border;
-    if (style->has("border")) {
-        auto shorthand = parseBorderShorthand(style->getString("border"));
-
+void Widget::applyLayoutStyle() {
+    const auto &computed = computedStyle();
+    auto &node = _layoutNode.style();
+    node.width = computed.width;
+    node.height = computed.height;
+    node.minWidth = computed.minWidth;
+    node.maxWidth = computed.maxWidth;
+    node.minHeight = computed.minHeight;
+    node.maxHeight = computed.maxHeight;
+    node.margin = computed.margin;
+    node.padding = computed.padding;
+    // Borders inset the content box like padding does, painting reads them from the computed style.
+    addBorder(node.padding.top, computed.border.top.width);
+    addBorder(node.padding.right, computed.border.right.width);
+    addBorder(node.padding.bottom, computed.border.bottom.width);
+    addBorder(node.padding.left, computed.border.left.width);
+    node.position = computed.position;
+    node.flex = computed.flex;
+    if (computed.display != DisplayType::Flex && computed.display != DisplayType::InlineFlex) {
+        // Block boxes stack their children in a column at full width.
+        node.flex.direction = FlexDirection::Column;
+        node.flex.wrap = FlexWrap::NoWrap;
+        node.flex.justifyContent = JustifyContent::FlexStart;
+        node.flex.alignItems = AlignItems::Stretch;
+    }
+    _layoutNode.markDirty();
 
-        if (shorthand.width || shorthand.style || shorthand.color) {
-            BorderEdge newEdge;
-            if (shorthand.width) newEdge.width = *shorthand.width;
-            if (shorthand.style) newEdge.style = *shorthand.style;
-            if (shorthand.color) newEdge.color = *shorthand.color;
-            border.setAllEdges(newEdge);
-        }
+    // display: none widgets leave their parent's node.
+    const bool hidden = computed.display == DisplayType::None;
+    if (hidden != _layoutHidden) {
+        _layoutHidden = hidden;
+        if (auto owner = parentWidget()) owner->markChildrenDirty();
     }
+}
 
-    // Border color shorthand
-    if (style->has("border-color")) {
-        auto colors = parseBorderColor(style->getString("border-color"));
-        border.top.color = colors[0];
-        border.right.color = colors[1];
-        border.bottom.color = colors[2];
-        border.left.color = colors[3];
+void Widget::markChildrenDirty() {
+    if (!_layoutChildrenStale) {
+        _layoutChildrenStale = true;
+        _component->getEngine()->queueLayoutChildren(_handle);
     }
+    _layoutNode.markDirty();
+}
 
-    // Border radius
-    if (style->has("border-radius")) {
-        border.radius = parseBorderRadius(style->getString("border-radius"));
+void Widget::syncLayoutChildren() {
+    if (!_layoutChildrenStale) return;
+    _layoutChildrenStale = false;
+    _layoutNode.removeAllChildren();
+    size_t index = 0;
+    for (size_t i = 0; i < layoutChildCount(); ++i) {
+        Widget *child = layoutChildAt(i);
+        if (!child || child->_layoutHidden) continue;
+        // A child moved here from another widget is still attached to that widget's node.
+        if (auto owner = child->_layoutNode.getParent()) owner->removeChild(&child->_layoutNode);
+        _layoutNode.insertChild(&child->_layoutNode, index++);
     }
+}
 
-    // Individual border edges
-    auto parseAndApplyEdge = [&](const std::string &propName, BorderEdge &edge) {
-        if (!style->has(propName)) return;
-        auto parts = parseBorderEdge(style->getString(propName));
-        if (parts.width) edge.width = *parts.width;
-        if (parts.style) edge.style = *parts.style;
-        if (parts.color) edge.color = *parts.color;
-    };
-
-    parseAndApplyEdge("border-top", border.top);
-    parseAndApplyEdge("border-right", border.right);
-    parseAndApplyEdge("border-bottom", border.bottom);
-    parseAndApplyEdge("border-left", border.left);
+void Widget::detachLayoutNode() {
+    _layoutNode.removeAllChildren();
+    if (auto owner = _layoutNode.getParent()) owner->removeChild(&_layoutNode);
+}
 
-    // Individual radius properties
-    if (style->has("border-top-left-radius"))
-        border.radius.topLeft = parseCSSValue(style->getString("border-top-left-radius"));
-    if (style->has("border-top-right-radius"))
-        border.radius.topRight = parseCSSValue(style->getString("border-top-right-radius"));
-    if (style->has("border-bottom-right-radius"))
-        border.radius.bottomRight = parseCSSValue(style->getString("border-bottom-right-radius"));
-    if (style->has("border-bottom-left-radius"))
-        border.radius.bottomLeft = parseCSSValue(style->getString("border-bottom-left-radius"));
+void Widget::setStyleProperty(StyleProperty property, std::string_view value) {
+    applyStyleProperty(mutableStyle(), property, value);
+    _styleDirty |= styleBit(property);
+    if (styleBit(property) & STYLE_LAYOUT_MASK) applyLayoutStyle();
+}
 
-    if (style->has("visibility")) {
-        widgetStyle.visibility = parseVisibility(style->getString("visibility"));
+void Widget::setStyleProperty(StyleProperty property, float value) {
+    if (!applyStyleNumber(mutableStyle(), property, value)) {
+        applyStyleProperty(mutableStyle(), property, formatCSSNumber(value));
     }
+    _styleDirty |= styleBit(property);
+    if (styleBit(property) & STYLE_LAYOUT_MASK) applyLayoutStyle();
+}
 
-    auto &flex = widgetStyle.flex;
-    if (style->has("justify-content")) {
-        flex.justifyContent = parseJustifyContent(style->getString("justify-content"));
-    }
-    if (style->has("align-items")) {
-        flex.alignItems = parseAlignItems(style->getString("align-items"));
-    }
-    if (style->has("align-content")) {
-        flex.alignContent = parseAlignContent(style->getString("align-content"));
-    }
-    if (style->has("flex-direction")) {
-        flex.direction = parseFlexDirection(style->getString("flex-direction"));
-    }
-    if (style->has("flex-wrap")) {
-        flex.wrap = parseFlexWrap(style->getString("flex-wrap"));
-    }
-    if (style->has("gap")) {
-        flex.gap = parseGap(style->getString("gap"));
+void Widget::resetPointer() {
+    if (available) return;
+    available = true;
+    // Null once the component is gone.
+    std::shared_ptr<Widget> self;
+    if (_component) {
+        if (_handle && _component->rootWidget() == _handle && !_component->unmounted()) {
+            _component->getEngine()->unmountComponent(*_component);
+        }
+        // Keeps this widget alive until it's done even if the component held the last reference.
+        self = _component->releaseWidget(*this);
     }
 
-    // Flex item properties
-    if (style->has("align-self")) {
-        flex.alignSelf = parseAlignItems(style->getString("align-self"));
-    }
-    if (style->has("flex")) {
-        auto shorthand = parseFlexShorthand(style->getString("flex"));
-        flex.flexGrow = shorthand.grow;
-        flex.flexShrink = shorthand.shrink;
-        if (shorthand.basis) flex.flexBasis = *shorthand.basis;
-    }
-    if (style->has("flex-grow")) {
-        flex.flexGrow = std::stof(style->getString("flex-grow"));
-    }
-    if (style->has("flex-shrink")) {
-        flex.flexShrink = std::stof(style->getString("flex-shrink"));
-    }
-    if (style->has("flex-basis")) {
-        flex.flexBasis = parseCSSValue(style->getString("flex-basis"));
-    }
+    goReset();
+    propMap.reset();
+    style.reset();
+    sharedStyle.reset();
+    ownStyle.reset();
+    detachLayoutNode();
+    _component = nullptr;
+}
+
+void Widget::unmountChild(WidgetHandle child) {
+    if (auto widget = resolve(child)) _component->getEngine()->reclaimer().unmount(*widget);
 }
 
-void ContainerWidget::addChild(std::shared_ptr<Widget> &widget) {
-    _children.emplace_back(widget);
-    widget->setParent(weak_from_this());
+void Widget::setStyleObject(std::unique_ptr<PropMap> newStyle) {
+    propMap->set(propKeyName(PropKey::Style), newStyle);
+    style = std::move(newStyle);
+    parseStyle();
+}
+
+void ContainerWidget::addChild(Widget &widget) {
+    _children.emplace_back(widget.handle());
+    widget.setParent(*this);
+    markChildrenDirty();
 }
 
 void ContainerWidget::addStaticChild(IEngine *engine, std::unique_ptr<WidgetHolder> widget) {
     if (_component->reconciliationStarted()) {
-        auto oldComponent = _component->reconcilingObject.lock();
-        if (oldComponent && widget->hasID()) {
-            auto it = oldComponent->staticChildren.find(widget->getID());
-            if (it != oldComponent->staticChildren.end()) {
-                size_t oldIndex = it->second;
+        auto oldComponent = dynamic_cast<ContainerWidget *>(resolve(_component->reconcilingObject));
+        if (oldComponent && widget->hasSlot()) {
+            size_t oldIndex = findSlot(oldComponent->staticChildren, widget->slot());
+            if (oldIndex != NO_CHILD) {
                 assert(oldIndex < oldComponent->_children.size() && "Static child index out of bounds");
-                _children.emplace_back(std::move(oldComponent->_children[oldIndex]));
+                slotEntry(staticChildren, widget->slot()) = _children.size();
+                _children.emplace_back(std::exchange(oldComponent->_children[oldIndex], WidgetHandle()));
+                if (auto child = childAt(_children.size() - 1)) child->setParent(*this);
+                markChildrenDirty();
                 return;
             }
         }
-        // If ID not found or no old component, treat as new static child (fallback)
+        // If the slot isn't found or no old component, treat as new static child (fallback)
     }
     // Initial render or new static child during reconciliation
     auto cmbx = widget->execute(engine);
     if (widget->isComponent()) {
-        childrenComponents.emplace_back(cmbx->component());
+        childrenComponents.emplace_back(cmbx->component()->shared_from_this());
     }
-    if (widget->hasID()) {
-        staticChildren[widget->getID()] = _children.size();
+    if (widget->hasSlot()) {
+        slotEntry(staticChildren, widget->slot()) = _children.size();
     }
-    _children.emplace_back(std::move(cmbx));
+    cmbx->setParent(*this);
+    _children.emplace_back(cmbx->handle());
+    markChildrenDirty();
 }
 
-void ContainerWidget::insertChild(IEngine *engine, std::string id, std::unique_ptr<WidgetHolder> holder) {
-    if (_component->reconciliationStarted()) {
-        auto reconcileComponent = _component->reconcilingObject.lock();
-        if (reconcileComponent && reconcileComponent->insertedChildren.count(id)) {
-            size_t index = reconcileComponent->insertedChildren[id];
-            assert(index < reconcileComponent->_children.size() && "Insertion ID has invalid child index");
-            auto newWidget = _component->reconcileObject(
-                reconcileComponent->_children[index], holder);
-            insertedChildren[id] = _children.size();
-            _children.emplace_back(newWidget);
-            return;
-        }
-        // If not found in an old component, treat as new child
-    }
-    // Handle both initial render and new child during reconciliation
-    if (insertedChildren.count(id) == 0) {
-        auto widget = holder->execute(engine);
-        widget->setParent(weak_from_this());
-        insertedChildren[id] = _children.size();
-        _children.emplace_back(std::move(widget));
-    } else {
-        auto newWidget = _component->reconcileObject(_children[insertedChildren[id]], holder);
-        newWidget->setParent(weak_from_this());
-        _children[insertedChildren[id]] = newWidget;
+size_t &ContainerWidget::slotEntry(std::vector<size_t> &table, ChildSlot slot) {
+    if (slot >= table.size()) {
+        table.resize(std::max<size_t>(slot + 1, _component->slotCount()), NO_CHILD);
     }
+    return table[slot];
+}
+
+size_t ContainerWidget::slotPosition(ChildSlot slot) {
+    auto &position = slotEntry(insertedChildren, slot);
+    if (position == NO_CHILD) {
+        position = _children.size();
+        _children.emplace_back();
+        ++emptySlots;
+    }
+    return position;
 }
 
-void ContainerWidget::insertChild(std::string id, SharedWidget widget) {
-    widget->setParent(weak_from_this());
-    if (insertedChildren.count(id) == 0) {
-        insertedChildren[id] = _children.size();
-        _children.push_back(std::move(widget));
+void ContainerWidget::insertSlot(IEngine *engine, ChildSlot slot, std::unique_ptr<WidgetHolder> holder) {
+    const size_t position = slotPosition(slot);
+    Widget *newWidget = nullptr;
+    auto *current = childAt(position);
+    if (!current) {
+        if (_component->reconciliationStarted()) {
+            auto reconcileComponent = dynamic_cast<ContainerWidget *>(resolve(_component->reconcilingObject));
+            size_t index = reconcileComponent ? findSlot(reconcileComponent->insertedChildren, slot) : NO_CHILD;
+            if (index != NO_CHILD) {
+                if (auto old = reconcileComponent->childAt(index)) newWidget = _component->reconcileObject(*old, holder);
+            }
+        }
+        // Initial render, a new child during reconciliation or a previously removed slot
+        if (!newWidget) newWidget = holder->execute(engine);
+        --emptySlots;
     } else {
-        _children[insertedChildren[id]] = widget;
+        newWidget = _component->reconcileObject(*current, holder);
+        if (newWidget != current && !isBorrowed(slot)) unmountChild(_children[position]);
     }
+    if (slot < borrowedChildren.size()) borrowedChildren[slot] = false;
+    newWidget->setParent(*this);
+    _children[position] = newWidget->handle();
+    markChildrenDirty();
+}
+
+void ContainerWidget::insertSlot(ChildSlot slot, Widget &widget, bool borrowed) {
+    widget.setParent(*this);
+    auto &current = _children[slotPosition(slot)];
+    if (!resolve(current)) {
+        --emptySlots;
+    } else if (current != widget.handle() && !isBorrowed(slot)) {
+        unmountChild(current);
+    }
+    current = widget.handle();
+    if (slot >= borrowedChildren.size()) borrowedChildren.resize(insertedChildren.size(), false);
+    borrowedChildren[slot] = borrowed;
+    markChildrenDirty();
 }
 
-void ContainerWidget::replaceChild(size_t index, const SharedWidget &widget) {
+void ContainerWidget::replaceChild(size_t index, Widget &widget) {
     //Freeing the widget and its children;
-    _children[index]->resetPointer();
-    _children[index] = widget;
+    unmountChild(_children[index]);
+    _children[index] = widget.handle();
+    widget.setParent(*this);
+    markChildrenDirty();
 }
 
-void ContainerWidget::removeChild(std::string &id) {
-    if (!insertedChildren.count(id)) {
-        //Item wasn't added. Go away
-        return;
-    }
-    auto index = insertedChildren[id];
-    _children.erase(_children.begin() + index);
-    insertedChildren.erase(id);
+void ContainerWidget::removeSlot(ChildSlot slot) {
+    // A slot removed before it was ever inserted still takes its position, so a later insert lands in source order.
+    auto &current = _children[slotPosition(slot)];
+    if (!resolve(current)) return;
+    if (!isBorrowed(slot)) unmountChild(current);
+    if (slot < borrowedChildren.size()) borrowedChildren[slot] = false;
+    current = {};
+    ++emptySlots;
+    markChildrenDirty();
 }
 
-void ContainerWidget::removeChild(size_t index) {
-    //freeing the pointer
-    _children[index]->resetPointer();
-    auto it = _children.begin();
-    std::advance(it, index);
-    _children.erase(std::move(it));
+void ContainerWidget::compactChildren() {
+    if (emptySlots == 0 && insertedChildren.empty() && staticChildren.empty()) return;
+    _children.erase(std::remove_if(_children.begin(), _children.end(), [this](WidgetHandle child) {
+        return !resolve(child);
+    }), _children.end());
+    insertedChildren.clear();
+    staticChildren.clear();
+    borrowedChildren.clear();
+    emptySlots = 0;
 }
 
-void ContainerWidget::replaceChildren(vector<std::shared_ptr<Widget> > vector) {
-    for (const auto &child: _children) {
-        child->resetPointer();
+void ContainerWidget::applyChildOps(const std::vector<ChildOp> &ops, const std::vector<Widget *> &inserted) {
+    bool changed = false;
+    _spareChildren.clear();
+    _spareChildren.reserve(ops.size());
+    for (const auto &op: ops) {
+        switch (op.kind) {
+            case ChildOpKind::Keep:
+            case ChildOpKind::Move:
+                // An empty slot is never carried into the new list.
+                if (!resolve(_children[op.index])) {
+                    changed = true;
+                    break;
+                }
+                _spareChildren.push_back(_children[op.index]);
+                changed |= op.kind == ChildOpKind::Move;
+                break;
+            case ChildOpKind::Insert:
+                inserted[op.index]->setParent(*this);
+                _spareChildren.push_back(inserted[op.index]->handle());
+                changed = true;
+                break;
+            case ChildOpKind::Remove:
+                unmountChild(_children[op.index]);
+                changed = true;
+                break;
+        }
     }
-    _children = std::move(vector);
+    _children.swap(_spareChildren);
+    _spareChildren.clear();
+    if (changed) markChildrenDirty();
 }
 
-void ContainerWidget::insertChild(size_t position, std::shared_ptr<Widget> widget) {
-    // Ensure position is within bounds
-    if (position >= _children.size()) {
-        _children.push_back(std::move(widget));
+void TextWidget::insertChild(ChildSlot slot, const std::string &text) {
+    if (slot >= insertedChildren.size()) {
+        insertedChildren.resize(std::max<size_t>(slot + 1, _component->slotCount()), NO_CHILD);
+    }
+    auto &index = insertedChildren[slot];
+    if (index == NO_CHILD) {
+        index = _children.size();
+        _children.emplace_back(text);
+    } else if (_children[index] != text) {
+        _children[index] = text;
+    } else {
         return;
     }
-    _children.insert(_children.begin() + position, std::move(widget));
-}
-
-void TextWidget::insertChild(std::string &id, const std::string &text) {
-    _children.emplace_back(text);
-    insertedChildren[id] = _children.size() - 1;
+    markLayoutDirty();
 }
 
 void HolderWidget::setChild(IEngine *engine, std::unique_ptr<WidgetHolder> holder) {
-    if (child) {
-        child = _component->reconcileObject(child, holder);
+    Widget *newChild;
+    if (auto current = resolve(child)) {
+        newChild = _component->reconcileObject(*current, holder);
+        if (newChild != current) unmountChild(child);
     } else {
-        child = holder->execute(engine);
+        newChild = holder->execute(engine);
+    }
+    child = newChild->handle();
+    newChild->setParent(*this);
+    markChildrenDirty();
+}
+
+masharif::Size TextWidget::measure(masharif::Node *node, float width, masharif::MeasureMode widthMode, float height,
+                                   masharif::MeasureMode heightMode) {
+    using masharif::MeasureMode;
+    const auto &text = *static_cast<TextWidget *>(node->getContext());
+    const auto &style = text.computedStyle();
+    const float fontSize = style.fontSize.isUndefined() ? DEFAULT_FONT_SIZE : style.fontSize.value;
+    const float lineHeight = style.lineHeight.isUndefined() ? fontSize * DEFAULT_LINE_HEIGHT : style.lineHeight.value;
+    size_t glyphs = 0;
+    for (const auto &child: text._children) {
+        for (const char c: child) {
+            if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) ++glyphs;
+        }
     }
+    // There is no font backend yet, glyphs are estimated at an average advance and wrapped at the available width.
+    const float advance = fontSize * AVERAGE_ADVANCE;
+    float contentWidth = glyphs * advance;
+    size_t lines = glyphs ? 1 : 0;
+    if (widthMode != MeasureMode::Undefined && contentWidth > width) {
+        const size_t perLine = std::max<size_t>(1, static_cast<size_t>(width / advance));
+        lines = (glyphs + perLine - 1) / perLine;
+        contentWidth = width;
+    }
+    masharif::Size size;
+    size.width = widthMode == MeasureMode::Exactly ? width : contentWidth;
+    size.height = heightMode == MeasureMode::Exactly ? height : lines * lineHeight;
+    if (heightMode == MeasureMode::AtMost) size.height = std::min(size.height, height);
+    return size;
 }
@@ -13,11 +13,16 @@
 #include <vector>
 #include <string>
 
+#include "../runtime/PropDiff.h"
 #include "../runtime/PropMap.h"
 
+#include "ChildSlot.h"
 #include "ComponentContext.h"
+#include "ListReconciler.h"
 #include "../utils/css/Style.h"
+#include "../utils/css/StyleCache.h"
 #include "Key.h"
+#include "WidgetHandle.h"
 
 class WidgetHolder;
 
@@ -32,20 +37,37 @@ enum WidgetType {
     BUTTON
 };
 
-class Widget : public std::enable_shared_from_this<Widget> {
+class Widget {
 protected:
     WidgetType _type;
     bool available = false;
-    std::weak_ptr<Widget> parent;
-    std::shared_ptr<ComponentContext> _component;
+    // Links in the component's widget list, the previous widget (or the component) owns this one.
+    friend class ComponentContext;
+    std::shared_ptr<Widget> nextInComponent;
+    Widget *previousInComponent = nullptr;
+    // Handles into the pool's WidgetTable, a destroyed parent resolves to nullptr.
+    WidgetHandle _handle;
+    WidgetHandle parent;
+    const WidgetTable *table = nullptr;
+    // Not owning, the engine holds mounted components and the ReclaimQueue unmounted ones until their widgets are gone.
+    ComponentContext *_component;
     std::unordered_map<std::string, std::string> props;
 
     std::unique_ptr<PropMap> style;
-    WidgetStyle widgetStyle;
-
-    Widget(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component,
+    // Interned in the engine's StyleCache, replaced by ownStyle once this widget changes its own style.
+    SharedStyle sharedStyle;
+    std::unique_ptr<WidgetStyle> ownStyle;
+    StyleDirtyMask _styleDirty = STYLE_ALL_DIRTY;
+    // Masharif lays the widget out, the node mirrors the layout part of the computed style and the visible children.
+    masharif::Node _layoutNode;
+    // Set until the node's children are rebuilt from the widget's, see markChildrenDirty.
+    bool _layoutChildrenStale = false;
+    bool _layoutHidden = false;
+
+    Widget(std::unique_ptr<PropMap> propMap, ComponentContext *component,
            WidgetType type): propMap(std::move(propMap))
-                             , _component(std::move(component)), _type(type) {
+                             , _component(component), _type(type) {
+        _layoutNode.setContext(this);
         parseProps();
     }
 
@@ -54,20 +76,113 @@ protected:
 
     void parseStyle();
 
+    // Copies the layout properties of the computed style onto the Masharif node.
+    void applyLayoutStyle();
+
+    // Called after the children changed, the node's children are rebuilt once before the next layout.
+    void markChildrenDirty();
+
+    void detachLayoutNode();
+
 
     virtual std::string getValue() =0;
 
-    bool operator==(const SharedWidget &other) {
-        return this->_type == other->_type && this->key == other->key;
+    // Detaches a removed child, its components are unmounted and it is freed later by the engine's ReclaimQueue.
+    void unmountChild(WidgetHandle child);
+
+    // The widget behind a child handle, nullptr for an empty slot or a widget that is gone.
+    Widget *resolve(WidgetHandle handle) const {
+        return table ? table->get(handle) : nullptr;
     }
 
 public:
     Key key;
     std::unique_ptr<PropMap> propMap;
 
+    // Called after propMap was updated in place by the engine's prop diff.
+    void applyPropDiff(const PropDiff &diff);
+
+    const WidgetStyle &computedStyle() const {
+        return ownStyle ? *ownStyle : *sharedStyle;
+    }
+
+    // Copy on write, the shared style is copied the first time this widget changes its style on its own.
+    WidgetStyle &mutableStyle() {
+        if (!ownStyle) {
+            ownStyle = std::make_unique<WidgetStyle>(*sharedStyle);
+            sharedStyle.reset();
+        }
+        return *ownStyle;
+    }
+
+    // Single property write from JS (`widget.style.width = ...`), no reparse of the whole style. The engine mirrors
+    // the value into the style object itself, see syncStyleObject. An empty value resets the property.
+    void setStyleProperty(StyleProperty property, std::string_view value);
+
+    void setStyleProperty(StyleProperty property, float value);
+
+    // Applies the style writes the engine deferred, before the style object is compared or read natively.
+    void syncStyleObject() const {
+        if (style) style->flush();
+    }
+
+    const std::unique_ptr<PropMap> &styleObject() const {
+        return style;
+    }
+
+    // Replaces the style object (`widget.style = {...}`) and reparses it.
+    void setStyleObject(std::unique_ptr<PropMap> newStyle);
+
+    StyleDirtyMask styleDirty() const {
+        return _styleDirty;
+    }
+
+    bool needsLayout() const {
+        return (_styleDirty & STYLE_LAYOUT_MASK) != 0;
+    }
+
+    bool needsPaint() const {
+        return _styleDirty != 0;
+    }
+
+    void clearStyleDirty(StyleDirtyMask mask = STYLE_ALL_DIRTY) {
+        _styleDirty &= ~mask;
+    }
+
+    // Position and size from the last layout, relative to the parent.
+    const masharif::Node &layoutNode() const {
+        return _layoutNode;
+    }
+
+    masharif::Node &layoutNode() {
+        return _layoutNode;
+    }
+
+    // Marks this widget for relayout, Masharif lets its ancestors know a descendant changed.
+    void markLayoutDirty() {
+        _layoutNode.markDirty();
+    }
+
+    // Rebuilds the node's children from the visible widget children. Called by the engine before layout.
+    void syncLayoutChildren();
+
+    // Children taking part in layout, an empty child slot is a nullptr.
+    virtual size_t layoutChildCount() const {
+        return 0;
+    }
+
+    virtual Widget *layoutChildAt(size_t index) const {
+        return nullptr;
+    }
+
+    // False for a layout child owned elsewhere, unmounting this widget leaves it to its owner.
+    virtual bool ownsLayoutChild(size_t index) const {
+        return true;
+    }
+
     template<class T>
-    std::shared_ptr<T> as() {
-        return std::dynamic_pointer_cast<T>(shared_from_this());
+    T *as() {
+        return dynamic_cast<T *>(this);
     }
 
     template<typename T>
@@ -75,38 +190,42 @@ public:
         return dynamic_cast<T *>(this);
     }
 
-    void reuse(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component) {
-        available = false;
-        this->_component = std::move(component);
-        this->propMap = std::move(propMap);
-        parseProps();
+    WidgetHandle handle() const {
+        return _handle;
     }
 
-    void setParent(const std::weak_ptr<Widget> &parent) {
-        this->parent = parent;
+    // Called by the WidgetPool once the widget is constructed and when its last owner lets go of it.
+    void attach(WidgetTable &widgets) {
+        table = &widgets;
+        _handle = widgets.insert(this);
     }
 
-    void resetPointer() {
-        if (available) return;
-        auto thisPtr = this;
-        auto found = std::find_if(_component->widgets.begin(), _component->widgets.end(),
-                                  [&](auto &c) {
-                                      //     std::cout << "Checking c: " << c.get() << " against this: " << thisPtr << "\n";
-                                      return c.get() == thisPtr;
-                                  });
-        if (found != _component->widgets.end())
-            _component->widgets.erase(std::move(found));
+    void detach(WidgetTable &widgets) {
+        widgets.erase(_handle);
+        _handle = {};
+    }
 
+    Widget *parentWidget() const {
+        return table ? table->get(parent) : nullptr;
+    }
 
-        goReset();
-        propMap.reset();
-        _component.reset();
+    void setParent(const Widget &parent) {
+        this->parent = parent._handle;
+    }
 
+    void clearParent() {
+        parent = {};
+    }
 
-        available = true;
+    // Moves the children to `out`, so they can be freed one by one instead of recursively.
+    virtual void releaseChildren(std::vector<WidgetHandle> &out) {
     }
 
-    std::shared_ptr<ComponentContext> &component() {
+    // Frees the widget and whatever subtree it still holds, unmounting the component if this is its root widget. The
+    // ReclaimQueue calls it after taking the children, see unmountChild.
+    void resetPointer();
+
+    ComponentContext *component() const {
         return _component;
     }
 
@@ -115,35 +234,53 @@ public:
     virtual void printTree(std::string prefix = "", bool isLast = true) =0;
 
     virtual ~Widget() {
+        detachLayoutNode();
         propMap.reset();
     };
 };
 
 class ContainerWidget : public Widget {
 public:
-    ContainerWidget(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component): Widget(
-        std::move(propMap), std::move(component), WidgetType::CONTAINER) {
+    ContainerWidget(std::unique_ptr<PropMap> propMap, ComponentContext *component): Widget(
+        std::move(propMap), component, WidgetType::CONTAINER) {
     }
 
-    void addChild(std::shared_ptr<Widget> &widget);
+    void addChild(Widget &widget);
 
     void addStaticChild(IEngine *engine, std::unique_ptr<WidgetHolder> widget);
 
-    void insertChild(IEngine *engine, std::string id, std::unique_ptr<WidgetHolder> holder);
+    void insertSlot(IEngine *engine, ChildSlot slot, std::unique_ptr<WidgetHolder> holder);
 
-    void insertChild(std::string id, SharedWidget widget);
+    // `borrowed` children are owned elsewhere (a holder's child) and are detached but not unmounted when replaced.
+    void insertSlot(ChildSlot slot, Widget &widget, bool borrowed = true);
+
+    // The child inserted at the slot if the container owns it, nullptr for an empty or borrowed slot.
+    Widget *ownedSlotChild(ChildSlot slot) const {
+        const size_t position = findSlot(insertedChildren, slot);
+        return position == NO_CHILD || isBorrowed(slot) ? nullptr : childAt(position);
+    }
 
 
     void goReset() override {
+        dropBorrowedChildren();
         //Children components need to be freed too
-        for (auto &element: _children) {
-            element->resetPointer();
+        for (const auto element: _children) {
+            // Static children moved to a re-executed component leave an empty slot behind.
+            if (auto child = resolve(element)) child->resetPointer();
         }
 
         _children.clear();
         props.clear();
     }
 
+    void releaseChildren(std::vector<WidgetHandle> &out) override {
+        dropBorrowedChildren();
+        for (const auto child: _children) {
+            if (child) out.push_back(child);
+        }
+        _children.clear();
+    }
+
     bool hasChildren() {
         return !_children.empty();
     }
@@ -158,39 +295,95 @@ public:
         cout << getValue() << endl;
 
         for (size_t i = 0; i < _children.size(); ++i) {
-            _children[i]->printTree(prefix + (isLast ? "      " : "|     "), i == _children.size() - 1);
+            auto child = childAt(i);
+            if (!child) continue;
+            child->printTree(prefix + (isLast ? "      " : "|     "), i == _children.size() - 1);
         }
     }
 
     std::string getValue() override {
-        return "Container with " + std::to_string(_children.size()) + " children";
+        return "Container with " + std::to_string(_children.size() - emptySlots) + " children";
     }
 
-    void replaceChild(size_t index, const SharedWidget &widget);
+    void replaceChild(size_t index, Widget &widget);
 
-    std::vector<std::shared_ptr<Widget> > &children() {
+    // Includes the empty slots of removed conditional children as null handles.
+    const std::vector<WidgetHandle> &children() const {
         return _children;
     }
 
-    //Will do dumb erase from the vector because its mainly used for list reconcile. If we ever needed to make it more complex, Please make sure
-    void removeChild(std::string &id);
-    void removeChild(size_t index);
+    Widget *childAt(size_t index) const {
+        return resolve(_children[index]);
+    }
+
+    size_t layoutChildCount() const override {
+        return _children.size();
+    }
+
+    Widget *layoutChildAt(size_t index) const override {
+        return childAt(index);
+    }
+
+    bool ownsLayoutChild(size_t index) const override {
+        for (size_t slot = 0; slot < borrowedChildren.size(); ++slot) {
+            if (borrowedChildren[slot] && insertedChildren[slot] == index) return false;
+        }
+        return true;
+    }
+
+    // Empties the slot, its position is kept so inserting it again is O(1) and doesn't move the other children.
+    void removeSlot(ChildSlot slot);
 
-    void replaceChildren(vector<std::shared_ptr<Widget> > vector);
+    // Drops the empty slots and forgets the slot positions, before the children are reconciled as a list.
+    void compactChildren();
 
-    void insertChild(size_t position, std::shared_ptr<Widget> widget);
+    // Rebuilds the children from a list reconcile result in one pass, see ComponentContext::reconcileWidgetHolders.
+    void applyChildOps(const std::vector<ChildOp> &ops, const std::vector<Widget *> &inserted);
 
 protected:
     std::vector<std::shared_ptr<ComponentContext> > childrenComponents;
-    std::vector<std::shared_ptr<Widget> > _children;
-    std::unordered_map<std::string, size_t> insertedChildren;
-    std::unordered_map<std::string, size_t> staticChildren;
+    // Children are owned by the components that created them, a container only refers to them.
+    std::vector<WidgetHandle> _children;
+    // The previous children buffer, swapped in by applyChildOps so rebuilding doesn't allocate.
+    std::vector<WidgetHandle> _spareChildren;
+    /**
+     * Slot to position in _children, NO_CHILD until the slot is first used. Sized to the component's slot count on
+     * first use. A slot keeps its position for the widget's lifetime, removing its child leaves a nullptr there, so
+     * conditional children toggle in place and never shift the positions of the others.
+     */
+    static constexpr size_t NO_CHILD = SIZE_MAX;
+    std::vector<size_t> insertedChildren;
+    size_t emptySlots = 0;
+    // Inserted children owned elsewhere (a holder's child), they are detached but not unmounted when replaced.
+    std::vector<bool> borrowedChildren;
+    std::vector<size_t> staticChildren;
+
+    size_t &slotEntry(std::vector<size_t> &table, ChildSlot slot);
+
+    // Position of an inserted slot, appending an empty one the first time the slot is seen.
+    size_t slotPosition(ChildSlot slot);
+
+    static size_t findSlot(const std::vector<size_t> &table, ChildSlot slot) {
+        return slot < table.size() ? table[slot] : NO_CHILD;
+    }
+
+    // Empties the positions of borrowed children, their owners free them.
+    void dropBorrowedChildren() {
+        for (size_t slot = 0; slot < borrowedChildren.size(); ++slot) {
+            if (borrowedChildren[slot]) _children[insertedChildren[slot]] = {};
+        }
+        borrowedChildren.clear();
+    }
+
+    bool isBorrowed(ChildSlot slot) const {
+        return slot < borrowedChildren.size() && borrowedChildren[slot];
+    }
 };
 
 class ButtonWidget : public ContainerWidget {
 public:
-    ButtonWidget(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component)
-        : ContainerWidget(std::move(propMap), std::move(component)) {
+    ButtonWidget(std::unique_ptr<PropMap> propMap, ComponentContext *component)
+        : ContainerWidget(std::move(propMap), component) {
     }
 
 
@@ -207,8 +400,8 @@ protected:
 
 class ImageWidget : public Widget {
 public:
-    explicit ImageWidget(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component): Widget(
-        std::move(propMap), std::move(component), WidgetType::IMAGE) {
+    explicit ImageWidget(std::unique_ptr<PropMap> propMap, ComponentContext *component): Widget(
+        std::move(propMap), component, WidgetType::IMAGE) {
     }
 
 
@@ -237,24 +430,30 @@ private:
 class TextWidget : public Widget {
 public:
     explicit TextWidget(std::unique_ptr<PropMap> propMap,
-                        std::shared_ptr<ComponentContext> component): Widget(
-        std::move(propMap), std::move(component), WidgetType::TEXT) {
+                        ComponentContext *component): Widget(
+        std::move(propMap), component, WidgetType::TEXT) {
+        _layoutNode.setMeasureFunction(&TextWidget::measure);
     }
 
 
     void goReset() override {
         _children.clear();
+        insertedChildren.clear();
     }
 
     void replaceChildren(std::vector<std::string> newChildren) {
+        if (newChildren == _children) return;
         _children = std::move(newChildren);
+        insertedChildren.clear();
+        markLayoutDirty();
     }
 
     void addText(const std::string &newText) {
         _children.push_back(newText);
+        markLayoutDirty();
     }
 
-    void addChild(std::shared_ptr<Widget> &widget) {
+    void addChild(Widget &widget) {
         throw std::runtime_error("You cannot add an child for a text widget");
     }
 
@@ -262,7 +461,8 @@ public:
         return _children;
     }
 
-    void insertChild(std::string &id, const std::string &text);
+    // Sets the text of a slot, appending it the first time.
+    void insertChild(ChildSlot slot, const std::string &text);
 
     void printTree(std::string prefix = "", bool isLast = true) override {
         cout << prefix;
@@ -283,7 +483,16 @@ public:
     };
 
 private:
-    std::unordered_map<std::string, size_t> insertedChildren;
+    static constexpr float DEFAULT_FONT_SIZE = 16;
+    static constexpr float DEFAULT_LINE_HEIGHT = 1.2f;
+    static constexpr float AVERAGE_ADVANCE = 0.5f;
+
+    // Masharif calls it for dirty text nodes only, a text change marks the node dirty.
+    static masharif::Size measure(masharif::Node *node, float width, masharif::MeasureMode widthMode, float height,
+                                  masharif::MeasureMode heightMode);
+
+    static constexpr size_t NO_CHILD = SIZE_MAX;
+    std::vector<size_t> insertedChildren;
     std::vector<std::string> _children;
 };
 
@@ -295,16 +504,29 @@ protected:
 
 public:
     explicit HolderWidget(std::unique_ptr<PropMap> propMap,
-                          std::shared_ptr<ComponentContext> component): Widget(
-        std::move(propMap), std::move(component), WidgetType::TEXT) {
+                          ComponentContext *component): Widget(
+        std::move(propMap), component, WidgetType::TEXT) {
     }
 
-    std::shared_ptr<Widget> child;
+    WidgetHandle child;
 
     void goReset() override {
-        child.reset();
+        child = {};
     };
 
+    void releaseChildren(std::vector<WidgetHandle> &out) override {
+        if (child) out.push_back(child);
+        child = {};
+    }
+
+    size_t layoutChildCount() const override {
+        return child ? 1 : 0;
+    }
+
+    Widget *layoutChildAt(size_t index) const override {
+        return resolve(child);
+    }
+
     void setChild(IEngine *engine, std::unique_ptr<WidgetHolder> holder) ;
 
     void printTree(std::string prefix, bool isLast) override {
@@ -313,7 +535,7 @@ public:
         if (!prefix.empty()) {
             cout << (isLast ? "|----- " : "|     ");
         }
-        child->printTree(prefix + (isLast ? "      " : "|     "));
+        if (auto widget = resolve(child)) widget->printTree(prefix + (isLast ? "      " : "|     "));
         cout << getValue() << endl;
     };
 };
@@ -0,0 +1,85 @@
+#ifndef WIDGETHANDLE_H
+#define WIDGETHANDLE_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+class Widget;
+
+// Index into a WidgetTable plus the generation of the slot when the handle was taken. The default handle is null.
+struct WidgetHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    explicit operator bool() const {
+        return generation != 0;
+    }
+
+    bool operator==(const WidgetHandle &other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const WidgetHandle &other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * Maps handles to live widgets. Removing a widget bumps its slot's generation, so every handle still pointing at the
+ * slot resolves to nullptr instead of a dangling or recycled widget. Lookups are an index and a compare, no
+ * refcounting.
+ */
+class WidgetTable {
+public:
+    WidgetHandle insert(Widget *widget) {
+        uint32_t index;
+        if (freeHead != NO_SLOT) {
+            index = freeHead;
+            freeHead = entries[index].nextFree;
+        } else {
+            index = static_cast<uint32_t>(entries.size());
+            entries.push_back({});
+        }
+        auto &entry = entries[index];
+        entry.widget = widget;
+        ++live;
+        return {index, entry.generation};
+    }
+
+    void erase(WidgetHandle handle) {
+        assert(get(handle) && "Erasing a stale widget handle");
+        auto &entry = entries[handle.index];
+        entry.widget = nullptr;
+        // 0 is reserved for null handles.
+        if (++entry.generation == 0) entry.generation = 1;
+        entry.nextFree = freeHead;
+        freeHead = handle.index;
+        --live;
+    }
+
+    Widget *get(WidgetHandle handle) const {
+        if (handle.index >= entries.size()) return nullptr;
+        const auto &entry = entries[handle.index];
+        return entry.generation == handle.generation ? entry.widget : nullptr;
+    }
+
+    size_t size() const {
+        return live;
+    }
+
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Entry {
+        Widget *widget = nullptr;
+        uint32_t generation = 1;
+        uint32_t nextFree = NO_SLOT;
+    };
+
+    std::vector<Entry> entries;
+    uint32_t freeHead = NO_SLOT;
+    size_t live = 0;
+};
+
+#endif //WIDGETHANDLE_H
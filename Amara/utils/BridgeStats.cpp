@@ -0,0 +1,42 @@
+#include "BridgeStats.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+const char *bridgeCallName(BridgeCall call) {
+    static constexpr const char *names[] = {
+#define AMARA_BRIDGE_CALL_NAME(name, string) string,
+        AMARA_BRIDGE_CALLS(AMARA_BRIDGE_CALL_NAME)
+#undef AMARA_BRIDGE_CALL_NAME
+    };
+    return names[static_cast<size_t>(call)];
+}
+
+// AMARA_BRIDGE_CALLS lists the host functions first.
+static bool isHostCall(BridgeCall call) {
+    return call < BridgeCall::CallComponent;
+}
+
+void BridgeStats::report(std::ostream &out) {
+    std::vector<BridgeCall> called;
+    for (size_t i = 0; i < BRIDGE_CALL_COUNT; ++i) {
+        if (counters[i].calls != 0) called.push_back(static_cast<BridgeCall>(i));
+    }
+    std::sort(called.begin(), called.end(), [](BridgeCall a, BridgeCall b) {
+        return counter(a).nanoseconds > counter(b).nanoseconds;
+    });
+
+    out << std::left << std::setw(28) << "entry point" << std::setw(12) << "direction" << std::right
+            << std::setw(10) << "calls" << std::setw(14) << "total ms" << std::setw(12) << "avg us" << "\n";
+    for (const auto call: called) {
+        const auto &entry = counter(call);
+        const double totalMs = static_cast<double>(entry.nanoseconds) / 1e6;
+        const double averageUs = static_cast<double>(entry.nanoseconds) / 1e3 / static_cast<double>(entry.calls);
+        out << std::left << std::setw(28) << bridgeCallName(call)
+                << std::setw(12) << (isHostCall(call) ? "js->native" : "native->js") << std::right
+                << std::setw(10) << entry.calls
+                << std::setw(14) << std::fixed << std::setprecision(3) << totalMs
+                << std::setw(12) << averageUs << "\n";
+    }
+}
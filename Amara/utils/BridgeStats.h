@@ -0,0 +1,125 @@
+#ifndef BRIDGESTATS_H
+#define BRIDGESTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Host functions JS calls into the engine with.
+#define AMARA_HOST_CALLS(X) \
+    X(Render, "render") \
+    X(Shutdown, "shutdown") \
+    X(CreateElement, "createElement") \
+    X(UseState, "useState") \
+    X(SetState, "setState") \
+    X(ToRaw, "toRaw") \
+    X(Effect, "effect") \
+    X(BeginComponent, "beginComponentInit") \
+    X(EndComponent, "endComponent") \
+    X(ListConciliar, "listConciliar") \
+    X(InsertChild, "widget.insertChild") \
+    X(AddChild, "widget.addChild") \
+    X(AddStaticChild, "widget.addStaticChild") \
+    X(SetChild, "widget.setChild") \
+    X(RemoveChild, "widget.removeChild") \
+    X(AddText, "widget.addText") \
+    X(InsertChildren, "widget.insertChildren") \
+    X(RemoveChildren, "widget.removeChildren") \
+    X(CellGet, "stateCell.get") \
+    X(CellSetValue, "stateCell.setValue")
+
+// JS functions the engine calls.
+#define AMARA_JS_CALLS(X) \
+    X(CallComponent, "component") \
+    X(CallStateInitializer, "useState initializer") \
+    X(CallStateUpdater, "setState updater") \
+    X(CallEffect, "effect callback") \
+    X(CallEffectCleanup, "effect cleanup") \
+    X(CallListItem, "list item") \
+    X(CallToString, "toString")
+
+#define AMARA_BRIDGE_CALLS(X) AMARA_HOST_CALLS(X) AMARA_JS_CALLS(X)
+
+enum class BridgeCall : unsigned char {
+#define AMARA_BRIDGE_CALL_ENUM(name, string) name,
+    AMARA_BRIDGE_CALLS(AMARA_BRIDGE_CALL_ENUM)
+#undef AMARA_BRIDGE_CALL_ENUM
+    Count
+};
+
+constexpr size_t BRIDGE_CALL_COUNT = static_cast<size_t>(BridgeCall::Count);
+
+const char *bridgeCallName(BridgeCall call);
+
+struct BridgeCounter {
+    uint64_t calls = 0;
+    // Inclusive, a host function that calls back into JS also holds the time of that call.
+    uint64_t nanoseconds = 0;
+};
+
+/**
+ * Per entry point call counts and times for everything crossing the C++/JS boundary. Off by default, a disabled
+ * BridgeScope costs one relaxed load. The engine is single threaded so the counters themselves aren't atomic.
+ */
+class BridgeStats {
+public:
+    static bool enabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled) {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    static void record(BridgeCall call, uint64_t nanoseconds) {
+        auto &counter = counters[static_cast<size_t>(call)];
+        ++counter.calls;
+        counter.nanoseconds += nanoseconds;
+    }
+
+    static const BridgeCounter &counter(BridgeCall call) {
+        return counters[static_cast<size_t>(call)];
+    }
+
+    static void reset() {
+        counters.fill({});
+    }
+
+    // Calls recorded over every entry point, zero while recording is off.
+    static uint64_t totalCalls() {
+        uint64_t total = 0;
+        for (const auto &counter: counters) total += counter.calls;
+        return total;
+    }
+
+    // Entry points that were called, slowest total first.
+    static void report(std::ostream &out);
+
+private:
+    static inline std::atomic<bool> _enabled{false};
+    static inline std::array<BridgeCounter, BRIDGE_CALL_COUNT> counters{};
+};
+
+class BridgeScope {
+public:
+    explicit BridgeScope(BridgeCall call) : call(call), active(BridgeStats::enabled()) {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+
+    BridgeScope(const BridgeScope &) = delete;
+
+    ~BridgeScope() {
+        if (!active) return;
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        BridgeStats::record(call, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+private:
+    BridgeCall call;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif //BRIDGESTATS_H
@@ -0,0 +1,65 @@
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a with a final mix, seeded so a perfect hash can be searched for at compile time.
+constexpr uint32_t hashName(std::string_view name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c: name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return h;
+}
+
+/**
+ * Perfect hash over a fixed list of names, built at compile time. find() is one hash and one compare, the index of
+ * the name in the list or NOT_FOUND.
+ */
+template<size_t N, size_t TableSize = 64>
+class NameTable {
+    static_assert(N < 0xFF && (TableSize & (TableSize - 1)) == 0, "NameTable needs a power of two table size");
+
+public:
+    static constexpr uint8_t NOT_FOUND = 0xFF;
+
+    constexpr explicit NameTable(const std::array<std::string_view, N> &names) : names(names) {
+        for (uint32_t candidate = 0; candidate < 4096; ++candidate) {
+            if (build(candidate)) {
+                seed = candidate;
+                return;
+            }
+        }
+    }
+
+    constexpr bool valid() const {
+        return seed != UINT32_MAX;
+    }
+
+    constexpr uint8_t find(std::string_view name) const {
+        const uint8_t index = slots[hashName(name, seed) & (TableSize - 1)];
+        return index != NOT_FOUND && names[index] == name ? index : NOT_FOUND;
+    }
+
+private:
+    constexpr bool build(uint32_t candidate) {
+        for (auto &slot: slots) slot = NOT_FOUND;
+        for (size_t i = 0; i < N; ++i) {
+            auto &slot = slots[hashName(names[i], candidate) & (TableSize - 1)];
+            if (slot != NOT_FOUND) return false;
+            slot = static_cast<uint8_t>(i);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> names;
+    std::array<uint8_t, TableSize> slots{};
+    uint32_t seed = UINT32_MAX;
+};
+
+#endif //NAMETABLE_H
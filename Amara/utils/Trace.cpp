@@ -0,0 +1,115 @@
+#include "Trace.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const char *traceCategoryName(TraceCategory category) {
+    static constexpr const char *names[] = {
+#define AMARA_TRACE_CATEGORY_NAME(name, string) string,
+        AMARA_TRACE_CATEGORIES(AMARA_TRACE_CATEGORY_NAME)
+#undef AMARA_TRACE_CATEGORY_NAME
+    };
+    return names[static_cast<size_t>(category)];
+}
+
+namespace {
+    struct TraceRegistry {
+        std::mutex mutex;
+        // Buffers outlive their threads so a session can still be exported after a worker exits.
+        std::vector<std::unique_ptr<TraceBuffer> > buffers;
+
+        static TraceRegistry &get() {
+            static TraceRegistry registry;
+            return registry;
+        }
+    };
+
+    void writeEscaped(std::ofstream &out, const char *text) {
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') out << '\\';
+            out << *text;
+        }
+    }
+}
+
+TraceBuffer &Trace::currentBuffer() {
+    thread_local TraceBuffer *buffer = nullptr;
+    if (!buffer) {
+        auto &registry = TraceRegistry::get();
+        std::lock_guard lock(registry.mutex);
+        const auto threadId = static_cast<uint32_t>(registry.buffers.size() + 1);
+        buffer = registry.buffers.emplace_back(std::make_unique<TraceBuffer>(threadId)).get();
+    }
+    return *buffer;
+}
+
+void Trace::start() {
+    auto &registry = TraceRegistry::get();
+    {
+        std::lock_guard lock(registry.mutex);
+        for (const auto &buffer: registry.buffers) {
+            buffer->clear();
+        }
+    }
+    _enabled.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    _enabled.store(false, std::memory_order_release);
+}
+
+bool Trace::writeChromeTrace(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    auto &registry = TraceRegistry::get();
+    std::lock_guard lock(registry.mutex);
+
+    uint64_t origin = UINT64_MAX;
+    for (const auto &buffer: registry.buffers) {
+        buffer->forEach([&](const TraceEvent &event) {
+            if (event.timestamp < origin) origin = event.timestamp;
+        });
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto &buffer: registry.buffers) {
+        size_t depth = 0;
+        buffer->forEach([&](const TraceEvent &event) {
+            // A wrapped ring can start in the middle of a span, its end has nothing to close.
+            if (event.type == TraceEventType::End) {
+                if (depth == 0) return;
+                --depth;
+            } else if (event.type == TraceEventType::Begin) {
+                ++depth;
+            }
+            if (!first) out << ',';
+            first = false;
+            out << "{\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"cat\":\"" << traceCategoryName(event.category) << "\",\"ph\":\"";
+            switch (event.type) {
+                case TraceEventType::Begin:
+                    out << 'B';
+                    break;
+                case TraceEventType::End:
+                    out << 'E';
+                    break;
+                case TraceEventType::Counter:
+                    out << 'C';
+                    break;
+            }
+            out << "\",\"ts\":" << static_cast<double>(event.timestamp - origin) / 1000.0
+                    << ",\"pid\":1,\"tid\":" << buffer->threadId;
+            if (event.type == TraceEventType::Counter) {
+                out << ",\"args\":{\"value\":" << event.value << '}';
+            }
+            out << '}';
+        });
+    }
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
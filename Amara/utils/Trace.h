@@ -0,0 +1,159 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#define AMARA_TRACE_CATEGORIES(X) \
+    X(Frame, "frame") \
+    X(Render, "render") \
+    X(Update, "update") \
+    X(Reconcile, "reconcile") \
+    X(Props, "props") \
+    X(Js, "js") \
+    X(Layout, "layout")
+
+enum class TraceCategory : unsigned char {
+#define AMARA_TRACE_CATEGORY_ENUM(name, string) name,
+    AMARA_TRACE_CATEGORIES(AMARA_TRACE_CATEGORY_ENUM)
+#undef AMARA_TRACE_CATEGORY_ENUM
+    Count
+};
+
+// Bit per TraceCategory, trace points of a category outside the mask compile to nothing. Set by the build.
+#ifndef AMARA_TRACE_CATEGORY_MASK
+#define AMARA_TRACE_CATEGORY_MASK 0xFFFFFFFFu
+#endif
+
+constexpr bool traceCategoryCompiled(TraceCategory category) {
+    return ((AMARA_TRACE_CATEGORY_MASK) >> static_cast<unsigned>(category) & 1u) != 0;
+}
+
+const char *traceCategoryName(TraceCategory category);
+
+enum class TraceEventType : unsigned char {
+    Begin,
+    End,
+    Counter
+};
+
+// Names have to be string literals, events only keep the pointer.
+struct TraceEvent {
+    const char *name;
+    uint64_t timestamp;
+    double value;
+    TraceCategory category;
+    TraceEventType type;
+};
+
+/**
+ * Fixed size ring of events written by a single thread. Once full the oldest events are overwritten, so tracing a
+ * long session keeps its most recent part. Readers should only look at it after Trace::stop.
+ */
+class TraceBuffer {
+public:
+    static constexpr size_t CAPACITY = 1 << 16;
+
+    explicit TraceBuffer(uint32_t threadId) : threadId(threadId) {
+    }
+
+    void push(const TraceEvent &event) {
+        const auto index = head.load(std::memory_order_relaxed);
+        events[index & (CAPACITY - 1)] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    // Calls `visit` for the events still in the ring, oldest first.
+    template<typename Visit>
+    void forEach(Visit visit) const {
+        const auto end = head.load(std::memory_order_acquire);
+        const auto begin = end > CAPACITY ? end - CAPACITY : 0;
+        for (auto i = begin; i < end; ++i) {
+            visit(events[i & (CAPACITY - 1)]);
+        }
+    }
+
+    void clear() {
+        head.store(0, std::memory_order_release);
+    }
+
+    const uint32_t threadId;
+
+private:
+    std::atomic<uint64_t> head{0};
+    std::array<TraceEvent, CAPACITY> events{};
+};
+
+/**
+ * Process wide trace session. Every thread records into its own TraceBuffer, the only lock is taken once per thread
+ * when its buffer is registered. Recording is off until start(), a trace point costs one relaxed load until then.
+ */
+class Trace {
+public:
+    static bool enabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    // Drops the events of the previous session.
+    static void start();
+
+    static void stop();
+
+    static void record(TraceCategory category, TraceEventType type, const char *name, double value = 0) {
+        currentBuffer().push({name, now(), value, category, type});
+    }
+
+    // Chrome trace event format, loads in chrome://tracing and ui.perfetto.dev.
+    static bool writeChromeTrace(const std::string &path);
+
+    static uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    static TraceBuffer &currentBuffer();
+
+    static inline std::atomic<bool> _enabled{false};
+};
+
+template<TraceCategory category>
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *name) : name(name) {
+        if constexpr (traceCategoryCompiled(category)) {
+            active = Trace::enabled();
+            if (active) Trace::record(category, TraceEventType::Begin, name);
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+
+    ~TraceSpan() {
+        if constexpr (traceCategoryCompiled(category)) {
+            if (active) Trace::record(category, TraceEventType::End, name);
+        }
+    }
+
+private:
+    const char *name;
+    bool active = false;
+};
+
+template<TraceCategory category>
+void traceCounter(const char *name, double value) {
+    if constexpr (traceCategoryCompiled(category)) {
+        if (Trace::enabled()) Trace::record(category, TraceEventType::Counter, name, value);
+    }
+}
+
+#define AMARA_TRACE_CONCAT_INNER(a, b) a##b
+#define AMARA_TRACE_CONCAT(a, b) AMARA_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) \
+    TraceSpan<TraceCategory::category> AMARA_TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_COUNTER(category, name, value) traceCounter<TraceCategory::category>(name, value)
+
+#endif //TRACE_H
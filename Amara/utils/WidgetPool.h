@@ -5,64 +5,398 @@
 #ifndef WIDGETPOOL_H
 #define WIDGETPOOL_H
 
-#include <unordered_map>
-#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <mutex>
-#include <typeindex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <vector>
 #include "../ui/Widget.h"
+#include "../ui/WidgetHandle.h"
 #include "../runtime/PropMap.h"
 
-class WidgetPool {
-public:
-    bool finished = false;
+struct WidgetPoolStats {
+    // Slots carved out of a chunk because the type's free list was empty.
+    size_t allocated = 0;
+    // Allocations served from a free list.
+    size_t reused = 0;
+    // Slots handed back to a free list.
+    size_t released = 0;
+    // Free slots whose memory was given back by trimming, and how many bytes that was.
+    size_t trimmed = 0;
+    size_t bytesReclaimed = 0;
+};
 
-    template<typename T>
-    std::shared_ptr<T> allocate(std::unique_ptr<PropMap> propMap, std::shared_ptr<ComponentContext> component) {
-        static_assert(std::is_base_of_v<Widget, T>, "T must derive from Widget");
+struct WidgetPoolPolicy {
+    // Slots reserved per widget type up front. A slab learns its slot size from its first allocation, so the
+    // reservation is carved as one chunk then.
+    size_t prewarm = 0;
+    // Free slots a type may hold before its empty chunks are given back.
+    size_t maxFreePerType = 4096;
+    // Idle frames (nothing scheduled) after which free slots are trimmed down to `prewarm`, 0 disables it.
+    size_t idleFramesBeforeTrim = 600;
+};
 
-        std::lock_guard lock(mutex_);
-        auto &free_list = free_lists[typeid(T)];
+/**
+ * Fixed size slots carved from contiguous chunks, freed slots are chained through their own storage. The slot size
+ * is taken from the first allocation, every slab only ever serves one type. Memory goes back a whole chunk at a time,
+ * once every slot in it is free.
+ */
+class Slab {
+public:
+    Slab() = default;
 
-        T *obj = nullptr;
+    Slab(const Slab &) = delete;
 
-        if (!free_list.empty()) {
-            obj = static_cast<T *>(free_list.back());
-            free_list.pop_back();
-            obj->reuse(std::move(propMap), std::move(component)); // Properly typed reset
-        } else {
-            obj = new T(std::move(propMap), std::move(component));
+    ~Slab() {
+        for (const auto &chunk: chunks) {
+            ::operator delete(chunk.memory, std::align_val_t(slotAlign));
         }
+    }
 
-        auto deleter = [this](Widget *ptr) {
-            if (finished) {
-                delete ptr;
-                return;
-            }
-            ptr->resetPointer(); // Generic cleanup
-            std::lock_guard lock(mutex_);
-            free_lists[typeid(*ptr)].push_back(ptr);
-        };
+    void *allocate(size_t size, size_t align, WidgetPoolStats &stats) {
+        if (slotSize == 0) {
+            slotSize = std::max(roundUp(size, align), sizeof(FreeSlot));
+            slotAlign = std::max(align, alignof(FreeSlot));
+        }
+        assert(size <= slotSize && align <= slotAlign && "A slab only serves one type");
+        if (freeList) {
+            auto *slot = freeList;
+            freeList = slot->next;
+            --freeCount;
+            ++stats.reused;
+            return slot;
+        }
+        if (cursor == chunkEnd) {
+            grow(std::max(chunkSlots, reserved));
+            reserved = 0;
+        }
+        auto *slot = cursor;
+        cursor += slotSize;
+        ++stats.allocated;
+        return slot;
+    }
 
-        return std::shared_ptr<T>(obj, deleter);
+    void deallocate(void *pointer, size_t maxFree, WidgetPoolStats &stats) {
+        freeList = new(pointer) FreeSlot{freeList};
+        ++freeCount;
+        ++stats.released;
+        // Trimming walks the whole free list, so after one that couldn't get below the cap (half empty chunks)
+        // the next waits until the list doubled.
+        if (freeCount > std::max(maxFree, trimRetryAt)) {
+            trim(maxFree, stats);
+            trimRetryAt = freeCount * 2;
+        }
     }
 
-    ~WidgetPool() {
-        clear();
+    // Makes sure `count` slots exist without further chunk allocations, deferred to the first allocation until the
+    // slot size is known.
+    void reserve(size_t count) {
+        reserved = count;
+        if (slotSize == 0) return;
+        const size_t available = freeCount + static_cast<size_t>(chunkEnd - cursor) / slotSize;
+        if (available < count) grow(count - available);
     }
 
-    void clear() {
-        for (auto &element: free_lists) {
-            for (auto p: element.second) {
-                delete p;
+    /**
+     * Gives chunks whose slots are all free back to the system until at most `keep` free slots are left. Returns the
+     * number of slots released.
+     */
+    size_t trim(size_t keep, WidgetPoolStats &stats) {
+        const size_t uncarved = slotSize ? static_cast<size_t>(chunkEnd - cursor) / slotSize : 0;
+        if (freeCount + uncarved <= keep) return 0;
+
+        // Free slots per chunk, chunks looked up by address.
+        byAddress.resize(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i) byAddress[i] = i;
+        std::sort(byAddress.begin(), byAddress.end(), [&](size_t a, size_t b) {
+            return chunks[a].memory < chunks[b].memory;
+        });
+        auto chunkOf = [&](const std::byte *slot) {
+            auto it = std::upper_bound(byAddress.begin(), byAddress.end(), slot, [&](const std::byte *p, size_t i) {
+                return p < chunks[i].memory;
+            });
+            return *(it - 1);
+        };
+        for (auto &chunk: chunks) chunk.freeSlots = 0;
+        for (auto *slot = freeList; slot; slot = slot->next) {
+            ++chunks[chunkOf(reinterpret_cast<std::byte *>(slot))].freeSlots;
+        }
+        if (uncarved) chunks[chunkOf(cursor)].freeSlots += uncarved;
+
+        // Biggest empty chunks first, so as many free slots as possible stay below `keep`.
+        emptyChunks.clear();
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (chunks[i].freeSlots == chunks[i].slots) emptyChunks.push_back(i);
+        }
+        std::sort(emptyChunks.begin(), emptyChunks.end(), [&](size_t a, size_t b) {
+            return chunks[a].slots > chunks[b].slots;
+        });
+        size_t remaining = freeCount + uncarved;
+        size_t releasedSlots = 0;
+        for (const size_t index: emptyChunks) {
+            if (remaining <= keep) break;
+            chunks[index].releasing = true;
+            remaining -= chunks[index].slots;
+            releasedSlots += chunks[index].slots;
+        }
+        if (releasedSlots == 0) return 0;
+
+        // Rebuild the free list without the released chunks' slots.
+        FreeSlot *kept = nullptr;
+        size_t keptCount = 0;
+        for (auto *slot = freeList; slot;) {
+            auto *next = slot->next;
+            if (!chunks[chunkOf(reinterpret_cast<std::byte *>(slot))].releasing) {
+                slot->next = kept;
+                kept = slot;
+                ++keptCount;
             }
+            slot = next;
+        }
+        freeList = kept;
+        freeCount = keptCount;
+        if (uncarved && chunks[chunkOf(cursor)].releasing) {
+            cursor = chunkEnd = nullptr;
+        }
+
+        size_t bytes = 0;
+        for (const auto &chunk: chunks) {
+            if (!chunk.releasing) continue;
+            bytes += chunk.slots * slotSize;
+            ::operator delete(chunk.memory, std::align_val_t(slotAlign));
         }
-        free_lists.clear();
+        chunks.erase(std::remove_if(chunks.begin(), chunks.end(), [](const Chunk &chunk) {
+            return chunk.releasing;
+        }), chunks.end());
+        stats.trimmed += releasedSlots;
+        stats.bytesReclaimed += bytes;
+        return releasedSlots;
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot *next;
     };
 
+    struct Chunk {
+        std::byte *memory;
+        size_t slots;
+        // Scratch for trim().
+        size_t freeSlots = 0;
+        bool releasing = false;
+    };
+
+    // Chunks double up to this many slots.
+    static constexpr size_t MAX_CHUNK_SLOTS = 1024;
+
+    static size_t roundUp(size_t size, size_t align) {
+        return (size + align - 1) / align * align;
+    }
+
+    void grow(size_t slots) {
+        // Whatever is left of the current chunk goes to the free list so it isn't lost.
+        for (; cursor != chunkEnd; cursor += slotSize) {
+            freeList = new(cursor) FreeSlot{freeList};
+            ++freeCount;
+        }
+        auto *memory = static_cast<std::byte *>(::operator new(slotSize * slots, std::align_val_t(slotAlign)));
+        chunks.push_back({memory, slots});
+        cursor = memory;
+        chunkEnd = memory + slotSize * slots;
+        chunkSlots = std::min(chunkSlots * 2, MAX_CHUNK_SLOTS);
+    }
+
+    FreeSlot *freeList = nullptr;
+    size_t freeCount = 0;
+    std::byte *cursor = nullptr;
+    std::byte *chunkEnd = nullptr;
+    std::vector<Chunk> chunks;
+    // Scratch for trim().
+    std::vector<size_t> byAddress;
+    std::vector<size_t> emptyChunks;
+    size_t slotSize = 0;
+    size_t slotAlign = 0;
+    size_t chunkSlots = 32;
+    size_t reserved = 0;
+    size_t trimRetryAt = 0;
+};
+
+template<typename Tag>
+class TaggedSlab : public Slab {
+};
+
+/**
+ * One slab per widget type, picked at compile time. Owned by the WidgetPool until it is destroyed; widgets (or weak
+ * pointers to them) still alive at that point keep the slabs around and the last one out frees them.
+ */
+template<typename... Types>
+class WidgetSlabs {
+public:
+    template<typename T>
+    Slab &slab() {
+        return std::get<TaggedSlab<T> >(slabs);
+    }
+
+    void *allocate(Slab &slab, size_t size, size_t align) {
+        assert(std::this_thread::get_id() == owner && "Widgets belong to the thread that created the pool");
+        ++live;
+        return slab.allocate(size, align, stats);
+    }
+
+    void deallocate(Slab &slab, void *pointer) {
+        assert(std::this_thread::get_id() == owner && "Widgets belong to the thread that created the pool");
+        slab.deallocate(pointer, policy.maxFreePerType, stats);
+        if (--live == 0 && orphaned) delete this;
+    }
+
+    void forEachSlab(const std::function<void(Slab &)> &visit) {
+        std::apply([&](auto &... slab) { (visit(slab), ...); }, slabs);
+    }
+
+    // Called by the pool's destructor.
+    void orphan() {
+        orphaned = true;
+        if (live == 0) delete this;
+    }
+
+    WidgetPoolStats stats;
+    WidgetPoolPolicy policy;
+    // Every live widget of the pool, what JS wrappers and parent links hold handles into.
+    WidgetTable table;
+    // Set while the engine tears down, widgets are destroyed without resetting their component links.
+    bool finished = false;
+
+private:
+    std::tuple<TaggedSlab<Types>...> slabs;
+    size_t live = 0;
+    bool orphaned = false;
+    const std::thread::id owner = std::this_thread::get_id();
+};
+
+using WidgetArena = WidgetSlabs<ContainerWidget, TextWidget, ImageWidget, ButtonWidget, HolderWidget>;
+
+/**
+ * Allocator for std::allocate_shared, so the widget and its shared_ptr control block share one slot. `Tag` is the
+ * widget type and stays the same when the standard library rebinds to its control block type.
+ */
+template<typename T, typename Tag>
+class WidgetSlotAllocator {
+public:
+    using value_type = T;
+
+    explicit WidgetSlotAllocator(WidgetArena *arena) : arena(arena) {
+    }
+
+    template<typename U>
+    WidgetSlotAllocator(const WidgetSlotAllocator<U, Tag> &other) : arena(other.arena) {
+    }
+
+    T *allocate(size_t count) {
+        assert(count == 1);
+        return static_cast<T *>(arena->allocate(arena->slab<Tag>(), sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T *pointer, size_t) {
+        arena->deallocate(arena->slab<Tag>(), pointer);
+    }
+
+    template<typename U, typename... Args>
+    void construct(U *pointer, Args &&... args) {
+        ::new(static_cast<void *>(pointer)) U(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of_v<Widget, U>) {
+            pointer->attach(arena->table);
+        }
+    }
+
+    // Runs the cleanup the pool's deleter used to run before the widget goes away, then invalidates its handle.
+    template<typename U>
+    void destroy(U *pointer) {
+        if constexpr (std::is_base_of_v<Widget, U>) {
+            if (!arena->finished) pointer->resetPointer();
+            pointer->detach(arena->table);
+        }
+        pointer->~U();
+    }
+
+    template<typename U>
+    bool operator==(const WidgetSlotAllocator<U, Tag> &other) const {
+        return arena == other.arena;
+    }
+
+    template<typename U>
+    bool operator!=(const WidgetSlotAllocator<U, Tag> &other) const {
+        return arena != other.arena;
+    }
+
+private:
+    template<typename, typename>
+    friend class WidgetSlotAllocator;
+
+    WidgetArena *arena;
+};
+
+/**
+ * Widget storage for one engine. Single threaded: it has no lock and asserts every allocation and free happens on
+ * the thread that created it.
+ */
+class WidgetPool {
+public:
+    WidgetPool() : arena(new WidgetArena()) {
+    }
+
+    WidgetPool(const WidgetPool &) = delete;
+
+    ~WidgetPool() {
+        arena->orphan();
+    }
+
+    template<typename T>
+    std::shared_ptr<T> allocate(std::unique_ptr<PropMap> propMap, ComponentContext *component) {
+        static_assert(std::is_base_of_v<Widget, T>, "T must derive from Widget");
+        return std::allocate_shared<T>(WidgetSlotAllocator<T, T>(arena), std::move(propMap), component);
+    }
+
+    // Applies the prewarm right away, the caps from the next free on.
+    void setPolicy(const WidgetPoolPolicy &policy) {
+        arena->policy = policy;
+        arena->forEachSlab([&](Slab &slab) { slab.reserve(policy.prewarm); });
+    }
+
+    const WidgetPoolPolicy &policy() const {
+        return arena->policy;
+    }
+
+    // Gives back empty chunks until each type holds at most `keep` free slots. Returns the slots released.
+    size_t trim(size_t keep) {
+        size_t released = 0;
+        arena->forEachSlab([&](Slab &slab) { released += slab.trim(keep, arena->stats); });
+        return released;
+    }
+
+    // Widgets released after this are destroyed without touching their components, see HermesEngine's destructor.
+    void finish() {
+        arena->finished = true;
+    }
+
+    const WidgetPoolStats &stats() const {
+        return arena->stats;
+    }
+
+    // The widget behind `handle`, nullptr once it was destroyed.
+    Widget *resolve(WidgetHandle handle) const {
+        return arena->table.get(handle);
+    }
+
+    size_t liveWidgets() const {
+        return arena->table.size();
+    }
+
 private:
-    std::unordered_map<std::type_index, std::vector<Widget *> > free_lists;
-    std::mutex mutex_;
+    WidgetArena *arena;
 };
 
 #endif //WIDGETPOOL_H
@@ -1,10 +1,10 @@
 #ifndef COLOR_H
 #define COLOR_H
 #include <iomanip>
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 class Color {
 public:
@@ -120,9 +120,16 @@ public:
         return {r, g, b, alpha};
     }
 
-    static bool isValid(const std::string& color) {
-        static std::regex hexPattern("^#([A-Fa-f0-9]{6}|[A-Fa-f0-9]{3})$");
-        return std::regex_match(color, hexPattern);
+    // Same formats setFromHex accepts: #RGB, #RGBA, #RRGGBB or #RRGGBBAA.
+    static bool isValid(std::string_view color) {
+        if (color.empty() || color[0] != '#') return false;
+        const size_t digits = color.size() - 1;
+        if (digits != 3 && digits != 4 && digits != 6 && digits != 8) return false;
+        for (size_t i = 1; i < color.size(); ++i) {
+            const char c = color[i];
+            if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))) return false;
+        }
+        return true;
     }
 };
 
@@ -1,32 +1,89 @@
 #include "CssUtils.h"
 
-std::vector<CSSValue> parseCSSValues(const std::string &input) {
-    std::vector<CSSValue> values;
-    std::vector<std::string> tokens = split(trim(input));
+#include <charconv>
+#include <cstdio>
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static char lowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string_view trim(std::string_view str) {
+    size_t start = 0;
+    while (start < str.size() && isSpace(str[start])) ++start;
+    size_t end = str.size();
+    while (end > start && isSpace(str[end - 1])) --end;
+    return str.substr(start, end - start);
+}
 
-    for (const auto &token: tokens) {
-        CSSValue value = parseCSSValue(token);
+CSSTokens tokenize(std::string_view input) {
+    CSSTokens tokens;
+    size_t i = 0;
+    while (i < input.size()) {
+        while (i < input.size() && isSpace(input[i])) ++i;
+        if (i == input.size()) break;
+        const size_t start = i;
+        while (i < input.size() && !isSpace(input[i])) ++i;
+        if (tokens.count == tokens.items.size()) {
+            // Too many values for any shorthand, callers treat it as invalid.
+            tokens.count++;
+            break;
+        }
+        tokens.items[tokens.count++] = input.substr(start, i - start);
+    }
+    return tokens;
+}
+
+bool caseInsensitiveCompare(std::string_view s1, std::string_view s2) {
+    if (s1.size() != s2.size()) return false;
+    for (size_t i = 0; i < s1.size(); ++i) {
+        // Quick check for exact match (common case)
+        if (s1[i] == s2[i]) continue;
+        if (lowerAscii(s1[i]) != lowerAscii(s2[i])) return false;
+    }
+    return true;
+}
+
+bool parseNumber(std::string_view input, float &value) {
+    input = trim(input);
+    // from_chars doesn't take a leading '+'
+    if (!input.empty() && input[0] == '+') input.remove_prefix(1);
+    if (input.empty()) return false;
+    const auto end = input.data() + input.size();
+    float parsed;
+    auto [ptr, ec] = std::from_chars(input.data(), end, parsed);
+    if (ec != std::errc() || ptr != end) return false;
+    value = parsed;
+    return true;
+}
+
+std::string formatCSSNumber(double value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", value);
+    return buffer;
+}
+
+std::vector<CSSValue> parseCSSValues(std::string_view input) {
+    std::vector<CSSValue> values;
+    const auto tokens = tokenize(input);
+    const size_t count = std::min(tokens.count, tokens.items.size());
+    for (size_t i = 0; i < count; ++i) {
+        CSSValue value = parseCSSValue(tokens[i]);
         if (!value.isUndefined()) {
             values.push_back(value);
         }
     }
-
     return values;
 }
 
-MarginPaddingValues parseMarginOrPadding(const std::string &input) {
+MarginPaddingValues parseMarginOrPadding(std::string_view input) {
     MarginPaddingValues result;
-    std::string trimmed = trim(input);
-    if (trimmed.empty()) return result;
-
-    std::vector<std::string> tokens;
-    std::istringstream stream(trimmed);
-    std::string token;
-    while (stream >> token) {
-        tokens.push_back(token);
-    }
+    const auto tokens = tokenize(input);
 
-    switch (tokens.size()) {
+    switch (tokens.count) {
         case 1:
             result.top = result.right = result.bottom = result.left = parseCSSValue(tokens[0]);
             break;
@@ -53,91 +110,37 @@ MarginPaddingValues parseMarginOrPadding(const std::string &input) {
     return result;
 }
 
-bool caseInsensitiveCompare(const std::string &s1, const std::string &s2) {
-    if (s1.size() != s2.size()) return false;
-    const auto len = s1.size();
-    const auto *p1 = s1.data();
-    const auto *p2 = s2.data();
-
-    for (size_t i = 0; i < len; ++i) {
-        const uint8_t c1 = p1[i];
-        const uint8_t c2 = p2[i];
+CSSValue parseCSSValue(std::string_view input) {
+    input = trim(input);
+    if (input.empty() || caseInsensitiveCompare(input, "auto")) return CSSValue();
 
-        // Quick check for exact match (common case)
-        if (c1 == c2) continue;
-
-        // Only convert to lowercase if needed
-        const int lc1 = std::tolower(c1);
-        const int lc2 = std::tolower(c2);
-
-        if (lc1 != lc2) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-std::string trim(const std::string &str) {
-    auto start = str.begin();
-    while (start != str.end() && std::isspace(*start)) ++start;
-
-    auto end = str.end();
-    do {
-        --end;
-    } while (end >= start && std::isspace(*end));
-
-    return {start, end + 1};
-}
-
-CSSValue parseCSSValue(const std::string &input) {
-    std::string trimmed = trim(input);
-    if (trimmed.empty()) return CSSValue();
-
-    // Check for 'auto' (case-insensitive)
-    if (caseInsensitiveCompare(trimmed, "auto") == 0) {
-        return CSSValue();
+    CSSUnit unit = CSSUnit::PX;
+    if (input.back() == '%') {
+        unit = CSSUnit::PERCENT;
+        input.remove_suffix(1);
+    } else if (input.size() > 2 && caseInsensitiveCompare(input.substr(input.size() - 2), "px")) {
+        input.remove_suffix(2);
     }
 
-    // Regular expression to match CSS values with units
-    static const std::regex pattern(
-        R"(^([+-]?\d*\.?\d+)(px|%)$)",
-        std::regex_constants::icase
-    );
-
-    std::smatch matches;
-    if (!std::regex_match(trimmed, matches, pattern)) {
+    float value;
+    if (!parseNumber(input, value)) {
         return CSSValue(); // Invalid format
     }
-
-    // Parse value and unit
-    float value = std::stof(matches[1].str());
-    std::string unitStr = toLower(matches[2].str());
-
-    if (unitStr == "%") {
-        return CSSValue(value, CSSUnit::PERCENT);
-    } else if (unitStr == "px") {
-        return CSSValue(value, CSSUnit::PX);
-    }
-
-    return CSSValue(); // Unknown unit
+    return CSSValue(value, unit);
 }
 
-std::vector<std::string> split(const std::string &s) {
-    std::vector<std::string> tokens;
-    std::istringstream stream(s);
-    std::string token;
-    while (stream >> token) {
-        tokens.emplace_back(token);
-    }
-    return tokens;
+// Colors go through Color's own validation, anything it can't parse stays at the default.
+static Color parseColor(std::string_view input) {
+    return Color::isValid(input) ? Color(input) : Color();
 }
 
-BorderShorthand parseBorderShorthand(const std::string &input) {
+BorderShorthand parseBorderShorthand(std::string_view input) {
     BorderShorthand result;
-    std::vector<std::string> tokens = split(trim(input));
+    const auto tokens = tokenize(input);
+    if (tokens.count > 3) return result;
 
-    for (const auto &token: tokens) {
+    for (size_t i = 0; i < tokens.count; ++i) {
+        const auto token = tokens[i];
         // Try color first (using your existing Color class)
         if (Color::isValid(token)) {
             result.color = Color(token);
@@ -161,22 +164,22 @@ BorderShorthand parseBorderShorthand(const std::string &input) {
     return result;
 }
 
-BorderStyle parseBorderStyle(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "none") return BorderStyle::NONE;
-    if (lower == "hidden") return BorderStyle::HIDDEN;
-    if (lower == "dotted") return BorderStyle::DOTTED;
-    if (lower == "dashed") return BorderStyle::DASHED;
-    if (lower == "solid") return BorderStyle::SOLID;
-    if (lower == "double") return BorderStyle::DOUBLE;
-    if (lower == "groove") return BorderStyle::GROOVE;
-    if (lower == "ridge") return BorderStyle::RIDGE;
-    if (lower == "inset") return BorderStyle::INSET;
-    if (lower == "outset") return BorderStyle::OUTSET;
+BorderStyle parseBorderStyle(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "none")) return BorderStyle::NONE;
+    if (caseInsensitiveCompare(input, "hidden")) return BorderStyle::HIDDEN;
+    if (caseInsensitiveCompare(input, "dotted")) return BorderStyle::DOTTED;
+    if (caseInsensitiveCompare(input, "dashed")) return BorderStyle::DASHED;
+    if (caseInsensitiveCompare(input, "solid")) return BorderStyle::SOLID;
+    if (caseInsensitiveCompare(input, "double")) return BorderStyle::DOUBLE;
+    if (caseInsensitiveCompare(input, "groove")) return BorderStyle::GROOVE;
+    if (caseInsensitiveCompare(input, "ridge")) return BorderStyle::RIDGE;
+    if (caseInsensitiveCompare(input, "inset")) return BorderStyle::INSET;
+    if (caseInsensitiveCompare(input, "outset")) return BorderStyle::OUTSET;
     return BorderStyle::NONE;
 }
 
-BorderWidths parseBorderWidth(const std::string &input) {
+BorderWidths parseBorderWidth(std::string_view input) {
     BorderWidths result;
     auto values = parseMarginOrPadding(input); // Reuse existing parser
     result.top = values.top;
@@ -187,11 +190,13 @@ BorderWidths parseBorderWidth(const std::string &input) {
 }
 
 
-ParsedBorderEdge parseBorderEdge(const std::string &input) {
+ParsedBorderEdge parseBorderEdge(std::string_view input) {
     ParsedBorderEdge result;
-    std::vector<std::string> tokens = split(trim(input));
+    const auto tokens = tokenize(input);
+    if (tokens.count > 3) return result;
 
-    for (const auto &token: tokens) {
+    for (size_t i = 0; i < tokens.count; ++i) {
+        const auto token = tokens[i];
         // First check for color (most specific)
         if (Color::isValid(token)) {
             result.color = Color(token);
@@ -216,26 +221,26 @@ ParsedBorderEdge parseBorderEdge(const std::string &input) {
 }
 
 
-std::array<Color, 4> parseBorderColor(const std::string &input) {
+std::array<Color, 4> parseBorderColor(std::string_view input) {
     std::array<Color, 4> colors;
-    std::vector<std::string> tokens = split(trim(input));
+    const auto tokens = tokenize(input);
 
-    switch (tokens.size()) {
+    switch (tokens.count) {
         case 1:
-            colors.fill(Color(tokens[0]));
+            colors.fill(parseColor(tokens[0]));
             break;
         case 2:
-            colors[0] = colors[2] = Color(tokens[0]);
-            colors[1] = colors[3] = Color(tokens[1]);
+            colors[0] = colors[2] = parseColor(tokens[0]);
+            colors[1] = colors[3] = parseColor(tokens[1]);
             break;
         case 3:
-            colors[0] = Color(tokens[0]);
-            colors[1] = colors[3] = Color(tokens[1]);
-            colors[2] = Color(tokens[2]);
+            colors[0] = parseColor(tokens[0]);
+            colors[1] = colors[3] = parseColor(tokens[1]);
+            colors[2] = parseColor(tokens[2]);
             break;
         case 4:
             for (int i = 0; i < 4; ++i)
-                colors[i] = Color(tokens[i]);
+                colors[i] = parseColor(tokens[i]);
             break;
         default:
             colors.fill(Color()); // Default to transparent
@@ -244,29 +249,28 @@ std::array<Color, 4> parseBorderColor(const std::string &input) {
 }
 
 
-BorderRadius parseBorderRadius(const std::string &input) {
+BorderRadius parseBorderRadius(std::string_view input) {
     BorderRadius radius;
-    std::vector<CSSValue> values = parseCSSValues(input);
+    const auto tokens = tokenize(input);
 
-    switch (values.size()) {
+    switch (tokens.count) {
         case 1:
-            radius = BorderRadius(values[0]);
+            radius = BorderRadius(parseCSSValue(tokens[0]));
             break;
         case 2:
-            radius.topLeft = values[0];
-            radius.bottomRight = values[0];
-            radius.topRight = radius.bottomLeft = values[1];
+            radius.topLeft = radius.bottomRight = parseCSSValue(tokens[0]);
+            radius.topRight = radius.bottomLeft = parseCSSValue(tokens[1]);
             break;
         case 3:
-            radius.topLeft = values[0];
-            radius.topRight = radius.bottomRight = values[1];
-            radius.bottomLeft = values[2];
+            radius.topLeft = parseCSSValue(tokens[0]);
+            radius.topRight = radius.bottomLeft = parseCSSValue(tokens[1]);
+            radius.bottomRight = parseCSSValue(tokens[2]);
             break;
         case 4:
-            radius.topLeft = values[0];
-            radius.topRight = values[1];
-            radius.bottomRight = values[2];
-            radius.bottomLeft = values[3];
+            radius.topLeft = parseCSSValue(tokens[0]);
+            radius.topRight = parseCSSValue(tokens[1]);
+            radius.bottomRight = parseCSSValue(tokens[2]);
+            radius.bottomLeft = parseCSSValue(tokens[3]);
             break;
         default:
             // Invalid input, return default
@@ -275,44 +279,54 @@ BorderRadius parseBorderRadius(const std::string &input) {
     return radius;
 }
 
-Visibility parseVisibility(const std::string &input) {
-    auto handled = trim(input);
-    if (caseInsensitiveCompare(handled, "visible") == 0) return Visibility::Visible;
-    if (caseInsensitiveCompare(handled, "hidden") == 0) return Visibility::Hidden;
-    if (caseInsensitiveCompare(handled, "collapse") == 0) return Visibility::Collapse;
-    if (caseInsensitiveCompare(handled, "unset") == 0) return Visibility::Unset;
-    if (caseInsensitiveCompare(handled, "inherit") == 0) return Visibility::Inherit;
+Visibility parseVisibility(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "visible")) return Visibility::Visible;
+    if (caseInsensitiveCompare(input, "hidden")) return Visibility::Hidden;
+    if (caseInsensitiveCompare(input, "collapse")) return Visibility::Collapse;
+    if (caseInsensitiveCompare(input, "unset")) return Visibility::Unset;
+    if (caseInsensitiveCompare(input, "inherit")) return Visibility::Inherit;
     return Visibility::Visible;
 }
 
 
-FlexShorthand parseFlexShorthand(const std::string &input) {
+FlexShorthand parseFlexShorthand(std::string_view input) {
     FlexShorthand result;
-    auto tokens = split(trim(input));
+    const auto tokens = tokenize(input);
 
-    switch (tokens.size()) {
+    switch (tokens.count) {
         case 1: {
-            auto value = parseCSSValue(tokens[0]);
-            if (!value.isUndefined()) {
-                result.basis = value;
+            if (caseInsensitiveCompare(tokens[0], "none")) {
+                result.shrink = 0;
+                break;
+            }
+            if (caseInsensitiveCompare(tokens[0], "auto")) {
+                result.grow = 1;
+                break;
+            }
+            float grow;
+            if (parseNumber(tokens[0], grow)) {
+                result.grow = grow;
             } else {
-                result.grow = std::stof(tokens[0]);
+                auto value = parseCSSValue(tokens[0]);
+                if (!value.isUndefined()) result.basis = value;
             }
             break;
         }
         case 2: {
-            result.grow = std::stof(tokens[0]);
-            auto value = parseCSSValue(tokens[1]);
-            if (!value.isUndefined()) {
-                result.basis = value;
+            parseNumber(tokens[0], result.grow);
+            float shrink;
+            if (parseNumber(tokens[1], shrink)) {
+                result.shrink = shrink;
             } else {
-                result.shrink = std::stof(tokens[1]);
+                auto value = parseCSSValue(tokens[1]);
+                if (!value.isUndefined()) result.basis = value;
             }
             break;
         }
         case 3: {
-            result.grow = std::stof(tokens[0]);
-            result.shrink = std::stof(tokens[1]);
+            parseNumber(tokens[0], result.grow);
+            parseNumber(tokens[1], result.shrink);
             result.basis = parseCSSValue(tokens[2]);
             break;
         }
@@ -323,71 +337,71 @@ FlexShorthand parseFlexShorthand(const std::string &input) {
     return result;
 }
 
-JustifyContent parseJustifyContent(const std::string &input) {
-    const std::string lower = toLower(trim(input));
-    if (lower == "flex-start") return JustifyContent::FlexStart;
-    if (lower == "flex-end") return JustifyContent::FlexEnd;
-    if (lower == "center") return JustifyContent::FlexCenter;
-    if (lower == "space-between") return JustifyContent::SpaceBetween;
-    if (lower == "space-around") return JustifyContent::SpaceAround;
-    if (lower == "space-evenly") return JustifyContent::SpaceEvenly;
+JustifyContent parseJustifyContent(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "flex-start")) return JustifyContent::FlexStart;
+    if (caseInsensitiveCompare(input, "flex-end")) return JustifyContent::FlexEnd;
+    if (caseInsensitiveCompare(input, "center")) return JustifyContent::FlexCenter;
+    if (caseInsensitiveCompare(input, "space-between")) return JustifyContent::SpaceBetween;
+    if (caseInsensitiveCompare(input, "space-around")) return JustifyContent::SpaceAround;
+    if (caseInsensitiveCompare(input, "space-evenly")) return JustifyContent::SpaceEvenly;
     return JustifyContent::FlexStart; // Default
 }
 
 // Parse align-items
-AlignItems parseAlignItems(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "flex-start") return AlignItems::FlexStart;
-    if (lower == "flex-end") return AlignItems::FlexEnd;
-    if (lower == "center") return AlignItems::FlexCenter;
-    if (lower == "stretch") return AlignItems::Stretch;
-    if (lower == "baseline") return AlignItems::Baseline;
-    if (lower == "auto") return AlignItems::AUTO_ALIGN;
+AlignItems parseAlignItems(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "flex-start")) return AlignItems::FlexStart;
+    if (caseInsensitiveCompare(input, "flex-end")) return AlignItems::FlexEnd;
+    if (caseInsensitiveCompare(input, "center")) return AlignItems::FlexCenter;
+    if (caseInsensitiveCompare(input, "stretch")) return AlignItems::Stretch;
+    if (caseInsensitiveCompare(input, "baseline")) return AlignItems::Baseline;
+    if (caseInsensitiveCompare(input, "auto")) return AlignItems::AUTO_ALIGN;
     return AlignItems::Stretch; // Default
 }
 
 // Parse align-content
-AlignContent parseAlignContent(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "flex-start") return AlignContent::FlexStart;
-    if (lower == "flex-end") return AlignContent::FlexEnd;
-    if (lower == "center") return AlignContent::FlexCenter;
-    if (lower == "stretch") return AlignContent::Stretch;
-    if (lower == "space-between") return AlignContent::SpaceBetween;
-    if (lower == "space-around") return AlignContent::SpaceAround;
+AlignContent parseAlignContent(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "flex-start")) return AlignContent::FlexStart;
+    if (caseInsensitiveCompare(input, "flex-end")) return AlignContent::FlexEnd;
+    if (caseInsensitiveCompare(input, "center")) return AlignContent::FlexCenter;
+    if (caseInsensitiveCompare(input, "stretch")) return AlignContent::Stretch;
+    if (caseInsensitiveCompare(input, "space-between")) return AlignContent::SpaceBetween;
+    if (caseInsensitiveCompare(input, "space-around")) return AlignContent::SpaceAround;
     return AlignContent::Stretch; // Default
 }
 
 // Parse flex-direction
-FlexDirection parseFlexDirection(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "row") return FlexDirection::Row;
-    if (lower == "column") return FlexDirection::Column;
-    if (lower == "row-reverse") return FlexDirection::RowReverse;
-    if (lower == "column-reverse") return FlexDirection::ColumnReverse;
+FlexDirection parseFlexDirection(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "row")) return FlexDirection::Row;
+    if (caseInsensitiveCompare(input, "column")) return FlexDirection::Column;
+    if (caseInsensitiveCompare(input, "row-reverse")) return FlexDirection::RowReverse;
+    if (caseInsensitiveCompare(input, "column-reverse")) return FlexDirection::ColumnReverse;
     return FlexDirection::Row; // Default
 }
 
 // Parse flex-wrap
-FlexWrap parseFlexWrap(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "nowrap") return FlexWrap::NoWrap;
-    if (lower == "wrap") return FlexWrap::Wrap;
-    if (lower == "wrap-reverse") return FlexWrap::WrapReverse;
+FlexWrap parseFlexWrap(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "nowrap")) return FlexWrap::NoWrap;
+    if (caseInsensitiveCompare(input, "wrap")) return FlexWrap::Wrap;
+    if (caseInsensitiveCompare(input, "wrap-reverse")) return FlexWrap::WrapReverse;
     return FlexWrap::NoWrap; // Default
 }
 
-Gap parseGap(const std::string &input) {
+Gap parseGap(std::string_view input) {
     Gap gap;
-    std::vector<CSSValue> values = parseCSSValues(input);
+    const auto tokens = tokenize(input);
 
-    switch (values.size()) {
+    switch (tokens.count) {
         case 1:
-            gap.row = gap.column = values[0];
+            gap.row = gap.column = parseCSSValue(tokens[0]);
             break;
         case 2:
-            gap.row = values[0];
-            gap.column = values[1];
+            gap.row = parseCSSValue(tokens[0]);
+            gap.column = parseCSSValue(tokens[1]);
             break;
         default:
             // Invalid input, use defaults
@@ -396,12 +410,241 @@ Gap parseGap(const std::string &input) {
     return gap;
 }
 
-DisplayType parseDisplay(const std::string &input) {
-    std::string lower = toLower(trim(input));
-    if (lower == "block") return DisplayType::Block;
-    if (lower == "inline-block") return DisplayType::InlineBlock;
-    if (lower == "flex") return DisplayType::Flex;
-    if (lower == "inline-flex") return DisplayType::InlineFlex;
-    if (lower == "none") return DisplayType::None;
+DisplayType parseDisplay(std::string_view input) {
+    input = trim(input);
+    if (caseInsensitiveCompare(input, "block")) return DisplayType::Block;
+    if (caseInsensitiveCompare(input, "inline-block")) return DisplayType::InlineBlock;
+    if (caseInsensitiveCompare(input, "flex")) return DisplayType::Flex;
+    if (caseInsensitiveCompare(input, "inline-flex")) return DisplayType::InlineFlex;
+    if (caseInsensitiveCompare(input, "none")) return DisplayType::None;
     return DisplayType::Block; // Default value
 }
+
+static void applyEdge(BorderEdge &edge, const ParsedBorderEdge &parts) {
+    if (parts.width) edge.width = *parts.width;
+    if (parts.style) edge.style = *parts.style;
+    if (parts.color) edge.color = *parts.color;
+}
+
+void applyStyleProperty(WidgetStyle &style, StyleProperty property, std::string_view value) {
+    auto &border = style.border;
+    auto &flex = style.flex;
+    switch (property) {
+        case StyleProperty::Display:
+            style.display = parseDisplay(value);
+            break;
+        case StyleProperty::Width:
+            style.width = parseCSSValue(value);
+            break;
+        case StyleProperty::Height:
+            style.height = parseCSSValue(value);
+            break;
+        case StyleProperty::Margin: {
+            auto values = parseMarginOrPadding(value);
+            auto &margin = style.margin;
+            margin.top = values.top;
+            margin.right = values.right;
+            margin.bottom = values.bottom;
+            margin.left = values.left;
+            break;
+        }
+        case StyleProperty::MarginTop:
+            style.margin.top = parseCSSValue(value);
+            break;
+        case StyleProperty::MarginRight:
+            style.margin.right = parseCSSValue(value);
+            break;
+        case StyleProperty::MarginBottom:
+            style.margin.bottom = parseCSSValue(value);
+            break;
+        case StyleProperty::MarginLeft:
+            style.margin.left = parseCSSValue(value);
+            break;
+        case StyleProperty::Padding: {
+            auto values = parseMarginOrPadding(value);
+            auto &padding = style.padding;
+            padding.top = values.top;
+            padding.right = values.right;
+            padding.bottom = values.bottom;
+            padding.left = values.left;
+            break;
+        }
+        case StyleProperty::PaddingTop:
+            style.padding.top = parseCSSValue(value);
+            break;
+        case StyleProperty::PaddingRight:
+            style.padding.right = parseCSSValue(value);
+            break;
+        case StyleProperty::PaddingBottom:
+            style.padding.bottom = parseCSSValue(value);
+            break;
+        case StyleProperty::PaddingLeft:
+            style.padding.left = parseCSSValue(value);
+            break;
+        case StyleProperty::Border: {
+            auto shorthand = parseBorderShorthand(value);
+            if (shorthand.width || shorthand.style || shorthand.color) {
+                BorderEdge newEdge;
+                if (shorthand.width) newEdge.width = *shorthand.width;
+                if (shorthand.style) newEdge.style = *shorthand.style;
+                if (shorthand.color) newEdge.color = *shorthand.color;
+                border.setAllEdges(newEdge);
+            }
+            break;
+        }
+        case StyleProperty::BorderColor: {
+            auto colors = parseBorderColor(value);
+            border.top.color = colors[0];
+            border.right.color = colors[1];
+            border.bottom.color = colors[2];
+            border.left.color = colors[3];
+            break;
+        }
+        case StyleProperty::BorderRadius:
+            border.radius = parseBorderRadius(value);
+            break;
+        case StyleProperty::BorderTop:
+            applyEdge(border.top, parseBorderEdge(value));
+            break;
+        case StyleProperty::BorderRight:
+            applyEdge(border.right, parseBorderEdge(value));
+            break;
+        case StyleProperty::BorderBottom:
+            applyEdge(border.bottom, parseBorderEdge(value));
+            break;
+        case StyleProperty::BorderLeft:
+            applyEdge(border.left, parseBorderEdge(value));
+            break;
+        case StyleProperty::BorderTopLeftRadius:
+            border.radius.topLeft = parseCSSValue(value);
+            break;
+        case StyleProperty::BorderTopRightRadius:
+            border.radius.topRight = parseCSSValue(value);
+            break;
+        case StyleProperty::BorderBottomRightRadius:
+            border.radius.bottomRight = parseCSSValue(value);
+            break;
+        case StyleProperty::BorderBottomLeftRadius:
+            border.radius.bottomLeft = parseCSSValue(value);
+            break;
+        case StyleProperty::Visibility:
+            style.visibility = parseVisibility(value);
+            break;
+        case StyleProperty::JustifyContent:
+            flex.justifyContent = parseJustifyContent(value);
+            break;
+        case StyleProperty::AlignItems:
+            flex.alignItems = parseAlignItems(value);
+            break;
+        case StyleProperty::AlignContent:
+            flex.alignContent = parseAlignContent(value);
+            break;
+        case StyleProperty::FlexDirection:
+            flex.direction = parseFlexDirection(value);
+            break;
+        case StyleProperty::FlexWrap:
+            flex.wrap = parseFlexWrap(value);
+            break;
+        case StyleProperty::Gap:
+            flex.gap = parseGap(value);
+            break;
+        case StyleProperty::AlignSelf:
+            flex.alignSelf = parseAlignItems(value);
+            break;
+        case StyleProperty::Flex: {
+            auto shorthand = parseFlexShorthand(value);
+            flex.flexGrow = shorthand.grow;
+            flex.flexShrink = shorthand.shrink;
+            if (shorthand.basis) flex.flexBasis = *shorthand.basis;
+            break;
+        }
+        case StyleProperty::FlexGrow:
+            parseNumber(value, flex.flexGrow);
+            break;
+        case StyleProperty::FlexShrink:
+            parseNumber(value, flex.flexShrink);
+            break;
+        case StyleProperty::FlexBasis:
+            flex.flexBasis = parseCSSValue(value);
+            break;
+        case StyleProperty::Opacity: {
+            float opacity;
+            if (parseNumber(value, opacity)) style.opacity = CSSValue(opacity, CSSUnit::PX);
+            break;
+        }
+        case StyleProperty::BackgroundColor:
+            style.backgroundColor = parseColor(value);
+            break;
+        case StyleProperty::Color:
+            style.textColor = parseColor(value);
+            break;
+        case StyleProperty::Count:
+            break;
+    }
+}
+
+bool applyStyleNumber(WidgetStyle &style, StyleProperty property, float value) {
+    const CSSValue length(value, CSSUnit::PX);
+    switch (property) {
+        case StyleProperty::Width:
+            style.width = length;
+            return true;
+        case StyleProperty::Height:
+            style.height = length;
+            return true;
+        case StyleProperty::Margin:
+            style.margin.top = style.margin.right = style.margin.bottom = style.margin.left = length;
+            return true;
+        case StyleProperty::MarginTop:
+            style.margin.top = length;
+            return true;
+        case StyleProperty::MarginRight:
+            style.margin.right = length;
+            return true;
+        case StyleProperty::MarginBottom:
+            style.margin.bottom = length;
+            return true;
+        case StyleProperty::MarginLeft:
+            style.margin.left = length;
+            return true;
+        case StyleProperty::Padding:
+            style.padding.top = style.padding.right = style.padding.bottom = style.padding.left = length;
+            return true;
+        case StyleProperty::PaddingTop:
+            style.padding.top = length;
+            return true;
+        case StyleProperty::PaddingRight:
+            style.padding.right = length;
+            return true;
+        case StyleProperty::PaddingBottom:
+            style.padding.bottom = length;
+            return true;
+        case StyleProperty::PaddingLeft:
+            style.padding.left = length;
+            return true;
+        case StyleProperty::Gap:
+            style.flex.gap.row = style.flex.gap.column = length;
+            return true;
+        case StyleProperty::FlexGrow:
+            style.flex.flexGrow = value;
+            return true;
+        case StyleProperty::FlexShrink:
+            style.flex.flexShrink = value;
+            return true;
+        case StyleProperty::FlexBasis:
+            style.flex.flexBasis = length;
+            return true;
+        case StyleProperty::Opacity:
+            style.opacity = length;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool applyStyleProperty(WidgetStyle &style, std::string_view name, std::string_view value) {
+    StyleProperty property;
+    if (!lookupStyleProperty(name, property)) return false;
+    applyStyleProperty(style, property, value);
+    return true;
+}
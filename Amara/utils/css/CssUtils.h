@@ -1,13 +1,15 @@
 #ifndef UITLS_H
 #define UITLS_H
 #include <string>
-#include <algorithm>
-#include <regex>
-#include <cctype>
+#include <string_view>
+#include <array>
+#include <optional>
+#include <vector>
 
 #include <masharifcore/Masharif.h>
 #include "BorderInfo.h"
 #include "Style.h"
+#include "StyleProperty.h"
 using namespace masharif;
 
 struct MarginPaddingValues {
@@ -23,54 +25,75 @@ struct FlexShorthand {
     std::optional<CSSValue> basis;
 };
 
-std::vector<CSSValue> parseCSSValues(const std::string &input);
+// Whitespace separated tokens of a shorthand value. No shorthand takes more than 4, `count` is 5 if there were more.
+struct CSSTokens {
+    std::array<std::string_view, 4> items;
+    size_t count = 0;
 
-MarginPaddingValues parseMarginOrPadding(const std::string &input);
+    const std::string_view &operator[](size_t index) const {
+        return items[index];
+    }
+};
+
+CSSTokens tokenize(std::string_view input);
+
+std::string_view trim(std::string_view str);
+
+bool caseInsensitiveCompare(std::string_view s1, std::string_view s2);
+
+// Plain number without unit, e.g. flex-grow. Returns false on anything else.
+bool parseNumber(std::string_view input, float &value);
+
+// Numbers coming from JS style objects, formatted the way the parser reads them back (`12`, `0.5`).
+std::string formatCSSNumber(double value);
 
-bool caseInsensitiveCompare(const std::string &s1, const std::string &s2);
+std::vector<CSSValue> parseCSSValues(std::string_view input);
 
-inline std::string trim(const std::string &str);
+MarginPaddingValues parseMarginOrPadding(std::string_view input);
 
-inline std::vector<std::string> split(const std::string &s);
+// `12px`, `50%` or a unitless number (treated as px). Anything else, including `auto`, is undefined.
+CSSValue parseCSSValue(std::string_view input);
 
-// Helper function to convert to lowercase
-inline std::string toLower(const std::string &str) {
-    std::string lowerStr = str;
-    std::transform(lowerStr.begin(), lowerStr.end(), lowerStr.begin(), ::tolower);
-    return lowerStr;
-}
+BorderShorthand parseBorderShorthand(std::string_view input);
 
-CSSValue parseCSSValue(const std::string &input);
+BorderStyle parseBorderStyle(std::string_view input);
 
-BorderShorthand parseBorderShorthand(const std::string &input);
+BorderWidths parseBorderWidth(std::string_view input);
 
-BorderStyle parseBorderStyle(const std::string &input);
+std::array<Color, 4> parseBorderColor(std::string_view input);
 
-BorderWidths parseBorderWidth(const std::string &input);
+BorderRadius parseBorderRadius(std::string_view input);
 
-BorderStyles parseBorderStyleShorthand(const std::string &input);
+ParsedBorderEdge parseBorderEdge(std::string_view input);
 
-std::array<Color, 4> parseBorderColor(const std::string &input);
+Visibility parseVisibility(std::string_view input);
 
-BorderRadius parseBorderRadius(const std::string &input);
+JustifyContent parseJustifyContent(std::string_view input);
 
-ParsedBorderEdge parseBorderEdge(const std::string &input);
+AlignItems parseAlignItems(std::string_view input);
 
-Visibility parseVisibility(const std::string &input);
+FlexShorthand parseFlexShorthand(std::string_view input);
 
-JustifyContent parseJustifyContent(const std::string &input);
+AlignContent parseAlignContent(std::string_view input);
 
-AlignItems parseAlignItems(const std::string &input);
+FlexDirection parseFlexDirection(std::string_view input);
 
-FlexShorthand parseFlexShorthand(const std::string &input);
+FlexWrap parseFlexWrap(std::string_view input);
 
-AlignContent parseAlignContent(const std::string &input);
+Gap parseGap(std::string_view input);
 
-FlexDirection parseFlexDirection(const std::string &input);
+DisplayType parseDisplay(std::string_view input);
 
-FlexWrap parseFlexWrap(const std::string &input);
+/**
+ * Parses one declaration into the style. Declarations are applied in the order they come in, so like css a later
+ * `margin` overrides an earlier `marginTop` and the other way around.
+ */
+void applyStyleProperty(WidgetStyle &style, StyleProperty property, std::string_view value);
 
-Gap parseGap(const std::string &input);
+// Numbers written from JS (`style.width = 12`) without formatting and reparsing them. Lengths are px. Returns false for
+// properties a bare number doesn't describe on its own, callers fall back to the string form.
+bool applyStyleNumber(WidgetStyle &style, StyleProperty property, float value);
 
-DisplayType parseDisplay(const std::string& input);
+// Same as above for a raw key, returns false if the key isn't a known style property.
+bool applyStyleProperty(WidgetStyle &style, std::string_view name, std::string_view value);
 #endif //UITLS_H
@@ -29,6 +29,12 @@ enum class DisplayType {
 };
 
 struct WidgetStyle {
+    WidgetStyle() {
+        // css defaults: children stretch, align-self follows the parent unless set.
+        flex.alignItems = AlignItems::Stretch;
+        flex.alignSelf = AlignItems::AUTO_ALIGN;
+    }
+
     CSSValue width;
     CSSValue height;
     CSSValue minWidth;
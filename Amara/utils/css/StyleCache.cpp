@@ -0,0 +1,92 @@
+#include "StyleCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "CssUtils.h"
+
+bool StyleCache::Builder::add(std::string_view name, std::string_view value) {
+    StyleProperty property;
+    if (!lookupStyleProperty(name, property)) return false;
+    value = trim(value);
+    // [property][length][value], the length keeps "a" + "bc" apart from "ab" + "c". It's a LEB128 varint, one byte
+    // for the usual short values and no upper bound.
+    key.push_back(static_cast<char>(property));
+    size_t length = value.size();
+    do {
+        const auto byte = static_cast<uint8_t>(length & 0x7F);
+        length >>= 7;
+        key.push_back(static_cast<char>(length ? byte | 0x80 : byte));
+    } while (length);
+    key.append(value);
+    return true;
+}
+
+// Flags a [property][double] entry, the property ids leave the top bit free.
+static constexpr uint8_t NUMBER_ENTRY = 0x80;
+static_assert(STYLE_PROPERTY_COUNT < NUMBER_ENTRY, "StyleCache keys flag number entries in the property byte");
+
+bool StyleCache::Builder::add(std::string_view name, double value) {
+    StyleProperty property;
+    if (!lookupStyleProperty(name, property)) return false;
+    key.push_back(static_cast<char>(static_cast<uint8_t>(property) | NUMBER_ENTRY));
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    key.append(bytes, sizeof(double));
+    return true;
+}
+
+SharedStyle StyleCache::Builder::build() {
+    if (key.empty()) return cache.defaultStyle();
+    return cache.intern(key);
+}
+
+StyleCache::StyleCache() : _defaultStyle(std::make_shared<const WidgetStyle>()) {
+}
+
+SharedStyle StyleCache::intern(const std::string &key) {
+    auto it = styles.find(key);
+    if (it != styles.end()) return it->second;
+
+    if (styles.size() >= nextCollect) {
+        collect();
+        nextCollect = std::max<size_t>(64, styles.size() * 2);
+    }
+
+    auto style = std::make_shared<WidgetStyle>();
+    for (size_t i = 0; i < key.size();) {
+        const auto tag = static_cast<uint8_t>(key[i++]);
+        const auto property = static_cast<StyleProperty>(tag & ~NUMBER_ENTRY);
+        if (tag & NUMBER_ENTRY) {
+            double number;
+            std::memcpy(&number, key.data() + i, sizeof(double));
+            i += sizeof(double);
+            if (!applyStyleNumber(*style, property, static_cast<float>(number))) {
+                applyStyleProperty(*style, property, formatCSSNumber(number));
+            }
+            continue;
+        }
+        size_t length = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const auto byte = static_cast<uint8_t>(key[i++]);
+            length |= static_cast<size_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        applyStyleProperty(*style, property, std::string_view(key).substr(i, length));
+        i += length;
+    }
+    SharedStyle shared = std::move(style);
+    styles.emplace(key, shared);
+    return shared;
+}
+
+void StyleCache::collect() {
+    for (auto it = styles.begin(); it != styles.end();) {
+        // The cache's own reference is the only one left.
+        if (it->second.use_count() == 1) {
+            it = styles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef STYLECACHE_H
+#define STYLECACHE_H
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Style.h"
+#include "StyleProperty.h"
+
+using SharedStyle = std::shared_ptr<const WidgetStyle>;
+
+/**
+ * Hash-consed computed styles. Widgets with the same style declarations (list rows mostly) share one immutable
+ * WidgetStyle, parsed once.
+ *
+ * Entries are keyed by the canonical form of the declarations: property ids instead of names, so "flexGrow" and
+ * "flex-grow" land on the same entry, and trimmed values. Order is kept since later declarations override earlier
+ * ones. Numbers from JS are keyed by their bits, not their text. Entries nobody holds anymore are dropped when the cache grows.
+ */
+class StyleCache {
+public:
+    // Builds the canonical key of a style declaration by declaration, then interns it.
+    class Builder {
+    public:
+        explicit Builder(StyleCache &cache) : cache(cache) {
+        }
+
+        // Returns false for keys that aren't style properties, they don't take part in the key.
+        bool add(std::string_view name, std::string_view value);
+
+        // Numbers are kept as is and only formatted if the property doesn't take a bare number.
+        bool add(std::string_view name, double value);
+
+        SharedStyle build();
+
+    private:
+        StyleCache &cache;
+        std::string key;
+    };
+
+    StyleCache();
+
+    StyleCache(const StyleCache &) = delete;
+
+    Builder builder() {
+        return Builder(*this);
+    }
+
+    // Shared by every widget without a style.
+    const SharedStyle &defaultStyle() const {
+        return _defaultStyle;
+    }
+
+    // Drops every style no widget holds anymore.
+    void collect();
+
+    size_t size() const {
+        return styles.size();
+    }
+
+private:
+    SharedStyle intern(const std::string &key);
+
+    SharedStyle _defaultStyle;
+    std::unordered_map<std::string, SharedStyle> styles;
+    size_t nextCollect = 64;
+};
+
+#endif //STYLECACHE_H
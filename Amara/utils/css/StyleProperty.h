@@ -0,0 +1,156 @@
+#ifndef STYLEPROPERTY_H
+#define STYLEPROPERTY_H
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "../NameTable.h"
+
+// Every style property the parser understands, as (enum name, css name, camelCase alias, what a change invalidates).
+#define AMARA_STYLE_PROPERTIES(X) \
+    X(Display, "display", "display", Layout) \
+    X(Width, "width", "width", Layout) \
+    X(Height, "height", "height", Layout) \
+    X(Margin, "margin", "margin", Layout) \
+    X(MarginTop, "margin-top", "marginTop", Layout) \
+    X(MarginRight, "margin-right", "marginRight", Layout) \
+    X(MarginBottom, "margin-bottom", "marginBottom", Layout) \
+    X(MarginLeft, "margin-left", "marginLeft", Layout) \
+    X(Padding, "padding", "padding", Layout) \
+    X(PaddingTop, "padding-top", "paddingTop", Layout) \
+    X(PaddingRight, "padding-right", "paddingRight", Layout) \
+    X(PaddingBottom, "padding-bottom", "paddingBottom", Layout) \
+    X(PaddingLeft, "padding-left", "paddingLeft", Layout) \
+    X(Border, "border", "border", Layout) \
+    X(BorderColor, "border-color", "borderColor", Paint) \
+    X(BorderRadius, "border-radius", "borderRadius", Paint) \
+    X(BorderTop, "border-top", "borderTop", Layout) \
+    X(BorderRight, "border-right", "borderRight", Layout) \
+    X(BorderBottom, "border-bottom", "borderBottom", Layout) \
+    X(BorderLeft, "border-left", "borderLeft", Layout) \
+    X(BorderTopLeftRadius, "border-top-left-radius", "borderTopLeftRadius", Paint) \
+    X(BorderTopRightRadius, "border-top-right-radius", "borderTopRightRadius", Paint) \
+    X(BorderBottomRightRadius, "border-bottom-right-radius", "borderBottomRightRadius", Paint) \
+    X(BorderBottomLeftRadius, "border-bottom-left-radius", "borderBottomLeftRadius", Paint) \
+    X(Visibility, "visibility", "visibility", Paint) \
+    X(JustifyContent, "justify-content", "justifyContent", Layout) \
+    X(AlignItems, "align-items", "alignItems", Layout) \
+    X(AlignContent, "align-content", "alignContent", Layout) \
+    X(FlexDirection, "flex-direction", "flexDirection", Layout) \
+    X(FlexWrap, "flex-wrap", "flexWrap", Layout) \
+    X(Gap, "gap", "gap", Layout) \
+    X(AlignSelf, "align-self", "alignSelf", Layout) \
+    X(Flex, "flex", "flex", Layout) \
+    X(FlexGrow, "flex-grow", "flexGrow", Layout) \
+    X(FlexShrink, "flex-shrink", "flexShrink", Layout) \
+    X(FlexBasis, "flex-basis", "flexBasis", Layout) \
+    X(Opacity, "opacity", "opacity", Paint) \
+    X(BackgroundColor, "background-color", "backgroundColor", Paint) \
+    X(Color, "color", "color", Paint)
+
+enum class StyleProperty : unsigned char {
+#define AMARA_STYLE_PROPERTY_ENUM(name, css, camel, effect) name,
+    AMARA_STYLE_PROPERTIES(AMARA_STYLE_PROPERTY_ENUM)
+#undef AMARA_STYLE_PROPERTY_ENUM
+    Count
+};
+
+constexpr size_t STYLE_PROPERTY_COUNT = static_cast<size_t>(StyleProperty::Count);
+
+// Layout changes need a relayout of the widget, paint changes only a repaint.
+enum class StyleEffect : unsigned char {
+    Layout,
+    Paint
+};
+
+// One bit per StyleProperty, set when the property changed since the last layout/paint.
+using StyleDirtyMask = uint64_t;
+static_assert(STYLE_PROPERTY_COUNT <= 64, "StyleDirtyMask has a bit per style property");
+
+constexpr StyleDirtyMask styleBit(StyleProperty property) {
+    return StyleDirtyMask(1) << static_cast<size_t>(property);
+}
+
+constexpr StyleDirtyMask STYLE_ALL_DIRTY = STYLE_PROPERTY_COUNT == 64
+                                               ? ~StyleDirtyMask(0)
+                                               : (StyleDirtyMask(1) << STYLE_PROPERTY_COUNT) - 1;
+
+constexpr StyleDirtyMask STYLE_LAYOUT_MASK = 0
+#define AMARA_STYLE_PROPERTY_LAYOUT(name, css, camel, effect) \
+    | (StyleEffect::effect == StyleEffect::Layout ? styleBit(StyleProperty::name) : 0)
+        AMARA_STYLE_PROPERTIES(AMARA_STYLE_PROPERTY_LAYOUT)
+#undef AMARA_STYLE_PROPERTY_LAYOUT
+        ;
+
+constexpr StyleDirtyMask STYLE_PAINT_MASK = STYLE_ALL_DIRTY & ~STYLE_LAYOUT_MASK;
+
+namespace style_property_detail {
+    inline constexpr std::string_view cssNames[] = {
+#define AMARA_STYLE_PROPERTY_CSS(name, css, camel, effect) css,
+        AMARA_STYLE_PROPERTIES(AMARA_STYLE_PROPERTY_CSS)
+#undef AMARA_STYLE_PROPERTY_CSS
+    };
+
+    inline constexpr std::string_view camelNames[] = {
+#define AMARA_STYLE_PROPERTY_CAMEL(name, css, camel, effect) camel,
+        AMARA_STYLE_PROPERTIES(AMARA_STYLE_PROPERTY_CAMEL)
+#undef AMARA_STYLE_PROPERTY_CAMEL
+    };
+
+    // Sparse enough that a collision free seed shows up after a handful of tries.
+    constexpr size_t TABLE_SIZE = 1024;
+    constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+    constexpr bool placeName(std::array<uint8_t, TABLE_SIZE> &table, std::string_view name, size_t property,
+                             uint32_t seed) {
+        auto &slot = table[hashName(name, seed) & (TABLE_SIZE - 1)];
+        if (slot != EMPTY_SLOT) return false;
+        slot = static_cast<uint8_t>(property);
+        return true;
+    }
+
+    // Returns a table with every css name and alias in its own slot, or an all empty table if the seed collides.
+    constexpr std::array<uint8_t, TABLE_SIZE> buildTable(uint32_t seed) {
+        std::array<uint8_t, TABLE_SIZE> table{};
+        for (auto &slot: table) slot = EMPTY_SLOT;
+        for (size_t i = 0; i < STYLE_PROPERTY_COUNT; ++i) {
+            bool placed = placeName(table, cssNames[i], i, seed);
+            if (placed && camelNames[i] != cssNames[i]) placed = placeName(table, camelNames[i], i, seed);
+            if (!placed) {
+                for (auto &slot: table) slot = EMPTY_SLOT;
+                return table;
+            }
+        }
+        return table;
+    }
+
+    constexpr uint32_t findSeed() {
+        for (uint32_t seed = 0; seed < 4096; ++seed) {
+            if (buildTable(seed)[hashName(cssNames[0], seed) & (TABLE_SIZE - 1)] != EMPTY_SLOT) return seed;
+        }
+        return UINT32_MAX;
+    }
+
+    inline constexpr uint32_t SEED = findSeed();
+    static_assert(SEED != UINT32_MAX, "No perfect hash seed for the style property names, grow TABLE_SIZE");
+    inline constexpr std::array<uint8_t, TABLE_SIZE> TABLE = buildTable(SEED);
+}
+
+/**
+ * Maps a style key (either "flex-direction" or "flexDirection") to its property with one hash and one compare.
+ * The table is a perfect hash built at compile time, unknown keys return false.
+ */
+constexpr bool lookupStyleProperty(std::string_view name, StyleProperty &property) {
+    using namespace style_property_detail;
+    const uint8_t index = TABLE[hashName(name, SEED) & (TABLE_SIZE - 1)];
+    if (index == EMPTY_SLOT) return false;
+    if (cssNames[index] != name && camelNames[index] != name) return false;
+    property = static_cast<StyleProperty>(index);
+    return true;
+}
+
+constexpr std::string_view styleCssName(StyleProperty property) {
+    return style_property_detail::cssNames[static_cast<size_t>(property)];
+}
+
+#endif //STYLEPROPERTY_H
@@ -1,222 +1,3 @@
-function createRef(initialValue, stateVariable = true) {
-    const VALUE_KEY = Symbol('stateValue');
-    const container = {
-        [VALUE_KEY]: initialValue,
-        // Store primitive type info for proper coercion
-        get [Symbol.toPrimitive]() {
-            return this[VALUE_KEY][Symbol.toPrimitive];
-        }
-    };
-
-    const handler = {
-        get(target, prop, receiver) {
-            // Handle special properties
-            if (prop === 'value' || prop === '_internalValueOf') return target[VALUE_KEY];
-            if (prop === 'setValue') return (newValue) => {
-                target[VALUE_KEY] = newValue
-            };
-            if (prop === '_isStateVariable') return stateVariable;
-
-            // Handle value coercion
-            if (prop === Symbol.toPrimitive) {
-                const val = target[VALUE_KEY];
-                return val[Symbol.toPrimitive] || function (hint) {
-                    return hint === 'string' ? String(val) : Number(val);
-                };
-            }
-
-            // Access actual value's properties
-            const currentValue = target[VALUE_KEY];
-            const valueObj = (typeof currentValue === 'object' && currentValue !== null)
-                ? currentValue
-                : Object(currentValue);
-
-            const value = Reflect.get(valueObj, prop, receiver);
-            return typeof value === 'function' ? value.bind(valueObj) : value;
-        },
-
-        set(target, prop, value, receiver) {
-            // Forward property sets to the actual value
-            if (typeof target[VALUE_KEY] === 'object' && target[VALUE_KEY] !== null) {
-                return Reflect.set(target[VALUE_KEY], prop, value, receiver);
-            }
-            throw new TypeError("Cannot set property on primitive value");
-        },
-
-        apply(target, thisArg, argumentsList) {
-            // Handle function calls
-            if (typeof target[VALUE_KEY] === 'function') {
-                return Reflect.apply(target[VALUE_KEY], thisArg, argumentsList);
-            }
-            throw new TypeError("Proxy value is not a function");
-        },
-
-        construct(target, argumentsList, newTarget) {
-            // Handle new operator
-            if (typeof target[VALUE_KEY] === 'function') {
-                return Reflect.construct(target[VALUE_KEY], argumentsList, newTarget);
-            }
-            throw new TypeError("Proxy value is not a constructor");
-        },
-
-        // Add trap for Object.keys, Object.entries, etc.
-        ownKeys(target) {
-            const value = target[VALUE_KEY];
-            if (typeof value === 'object' && value !== null) {
-                return Reflect.ownKeys(value);
-            }
-            return [];
-        },
-
-        // Add trap for property descriptors
-        getOwnPropertyDescriptor(target, prop) {
-            const value = target[VALUE_KEY];
-            if (typeof value === 'object' && value !== null) {
-                return Reflect.getOwnPropertyDescriptor(value, prop);
-            }
-            return undefined;
-        },
-
-        // Add other necessary traps
-        getPrototypeOf() {
-            return Reflect.getPrototypeOf(container[VALUE_KEY]);
-        },
-
-        has(target, prop) {
-            if (prop === "_isStateVariable") {
-                return true;
-            }
-            return Reflect.has(container[VALUE_KEY], prop);
-        },
-        spread() {
-            return {...container[VALUE_KEY]};
-        },
-
-        // Support for Object spread {...obj}
-        defineProperty(target, prop, descriptor) {
-            if (typeof target[VALUE_KEY] === 'object' && target[VALUE_KEY] !== null) {
-                return Reflect.defineProperty(target[VALUE_KEY], prop, descriptor);
-            }
-            return false;
-        }
-    };
-
-    return new Proxy(container, handler);
-}
-
-function diffAndUpdate(obj1, obj2) {
-    const changes = {
-        added: [],
-        removed: [],
-        changed: [],
-    };
-
-    // Move helper functions outside of main function for better performance
-    function isObject(val) {
-        return val && typeof val === 'object' && !Array.isArray(val);
-    }
-
-    function isEqual(a, b) {
-        // Fast path for identity comparison
-        if (a === b) return true;
-        if (a == null || b == null) return false;
-        if (typeof a !== typeof b) return false;
-
-        // Object comparison
-        if (isObject(a) && isObject(b)) {
-            const aKeys = Object.keys(a);
-            const bKeys = Object.keys(b);
-            if (aKeys.length !== bKeys.length) return false;
-
-            // Use a for loop instead of .every() for better performance
-            for (let i = 0; i < aKeys.length; i++) {
-                const key = aKeys[i];
-                if (!b.hasOwnProperty(key) || !isEqual(a[key], b[key])) {
-                    return false;
-                }
-            }
-            return true;
-        }
-
-        // Array comparison
-        if (Array.isArray(a) && Array.isArray(b)) {
-            if (a.length !== b.length) return false;
-
-            for (let i = 0; i < a.length; i++) {
-                if (!isEqual(a[i], b[i])) return false;
-            }
-            return true;
-        }
-
-        return false;
-    }
-
-    function compareAndUpdate(o1, o2, path = '') {
-        // Early return for edge cases
-        if (o1 === o2) return;
-        if (!o1 || !o2) {
-            // Handle null/undefined cases
-            if (!o1 && o2) {
-                Object.assign(o1, o2);
-                changes.added.push({key: path, value: o2});
-            } else if (o1 && !o2) {
-                for (const key in o1) {
-                    delete o1[key];
-                }
-                changes.removed.push({key: path, value: o1});
-            }
-            return;
-        }
-
-        // Create key sets once
-        const keys1 = Object.keys(o1);
-        const keys2 = Object.keys(o2);
-        const keys1Set = new Set(keys1);
-        const keys2Set = new Set(keys2);
-
-        // Handle added keys
-        for (const key of keys2) {
-            if (key === 'children') continue;
-            //events will always be different, so we don't need to check on it.
-            if (key.startsWith("on")) continue;
-
-            const fullPath = path ? `${path}.${key}` : key;
-
-            if (!keys1Set.has(key)) {
-                o1[key] = o2[key];
-                changes.added.push({key: fullPath, value: o2[key]});
-            }
-        }
-
-        // Handle removed and changed keys
-        for (const key of keys1) {
-            if (key === 'children') continue;
-
-            const fullPath = path ? `${path}.${key}` : key;
-            const val1 = o1[key];
-
-            if (!keys2Set.has(key)) {
-                delete o1[key];
-                changes.removed.push({key: fullPath, value: val1});
-            } else {
-                const val2 = o2[key];
-
-                if (!isEqual(val1, val2)) {
-                    if (isObject(val1) && isObject(val2)) {
-                        compareAndUpdate(val1, val2, fullPath);
-                    } else {
-                        o1[key] = val2;
-                        changes.changed.push({key: fullPath, from: val1, to: val2});
-                    }
-                }
-            }
-        }
-    }
-
-    compareAndUpdate(obj1, obj2);
-    return changes;
-}
-
 function _slicedToArray(r, e) {
     return _arrayWithHoles(r) || _iterableToArrayLimit(r, e) || _unsupportedIterableToArray(r, e) || _nonIterableRest();
 }
@@ -239,10 +20,6 @@ function _arrayLikeToArray(r, a) {
     return n;
 }
 
-function toRaw(value) {
-    return value._isStateVariable ? value.value : value
-}
-
 function _iterableToArrayLimit(r, l) {
     var t = null == r ? null : "undefined" != typeof Symbol && r[Symbol.iterator] || r["@@iterator"];
     if (null != t) {
@@ -270,7 +47,7 @@ function _arrayWithHoles(r) {
 }
 
 function TaskBoard() {
-    beginComponentInit("sVQwNuCG");
+    beginComponentInit("sVQwNuCG", 3);
     const [columns, setColumns] = useState({
         todo: ['Buy milk', 'Write blog'],
         doing: ['Learn React'],
@@ -329,8 +106,7 @@ function TaskBoard() {
                         "component": 'text',
                         "props": {
                             "children": [col.toUpperCase()]
-                        },
-                        "id": "BVRijwT7"
+                        }
                     }, ...columns[col].map(task => ({
                         "$$internalComponent": false,
                         "component": Child,
@@ -344,29 +120,25 @@ function TaskBoard() {
                                     "component": 'text',
                                     "props": {
                                         "children": ["MYYY"]
-                                    },
-                                    "id": "BVRijwT7"
+                                    }
                                 }
                             ]
-                        },
-                        "id": "j2NTT4PU"
+                        }
                     }))]
-                },
-                "id": "tv3Dmam"
+                }
             }));
         }, [columns]);
         _parent.addChild(_mapParent);
         const _element2 = createElement("div", {});
         effect(() => {
-            _element2.insertChild("Os9p4w13", {
+            _element2.insertChild(1, {
                 "$$internalComponent": true,
                 "component": "div",
                 "props": {
                     value: toRaw(newTask),
                     onChange: e => setNewTask(e.target.value),
                     "children": []
-                },
-                "id": "LGJB0j4O"
+                }
             });
         }, [newTask]);
         _element2.addStaticChild({
@@ -376,7 +148,7 @@ function TaskBoard() {
                 onClick: handleAddTask,
                 "children": ["Add Task"]
             },
-            "id": "xF9628E"
+            "slot": 2
         });
         _parent.addChild(_element2);
         endComponent();
@@ -390,7 +162,7 @@ function Child({children,
                    col,
                    moveTask
                }) {
-    beginComponentInit("KEOKV9N8");
+    beginComponentInit("KEOKV9N8", 6);
     {
         const _parent4 = createElement("div", {
             key: toRaw(task),
@@ -403,7 +175,7 @@ function Child({children,
         }, [task]);
         const _element6 = createElement("text", {});
         effect(() => {
-            _element6.insertChild("lPjJ8JRt", toRaw(task));
+            _element6.insertChild(1, toRaw(task));
         }, [task]);
         _parent4.addChild(_element6);
         const _element7 = createElement("div", {});
@@ -413,7 +185,7 @@ function Child({children,
             "props": {
                 "children": ["Move To"]
             },
-            "id": "5IAYCAQ6"
+            "slot": 5
         });
         const _holder = createElement("holder", {});
         effect(() => {
@@ -423,15 +195,14 @@ function Child({children,
                 "props": {
                     onClick: () => moveTask(toRaw(task), toRaw(col), 'todo'),
                     "children": ["To Do"]
-                },
-                "id": "P567npIC"
+                }
             });
         }, [moveTask]);
         effect(() => {
             if (col !== 'todo') {
-                _element7.insertChild("lRJuCVsR", _holder);
+                _element7.insertChild(2, _holder);
             } else {
-                _element7.removeChild("lRJuCVsR");
+                _element7.removeChild(2);
             }
         }, [col]);
         const _holder2 = createElement("holder", {});
@@ -442,15 +213,14 @@ function Child({children,
                 "props": {
                     onClick: () => moveTask(toRaw(task), toRaw(col), 'doing'),
                     "children": ["Doing"]
-                },
-                "id": "ENfwYMaT"
+                }
             });
         }, [moveTask]);
         effect(() => {
             if (col !== 'doing') {
-                _element7.insertChild("GGN60Egd", _holder2);
+                _element7.insertChild(3, _holder2);
             } else {
-                _element7.removeChild("GGN60Egd");
+                _element7.removeChild(3);
             }
         }, [col]);
         const _holder3 = createElement("holder", {});
@@ -461,15 +231,14 @@ function Child({children,
                 "props": {
                     onClick: () => moveTask(toRaw(task), toRaw(col), 'done'),
                     "children": ["Done"]
-                },
-                "id": "yLCTEA3c"
+                }
             });
         }, [moveTask]);
         effect(() => {
             if (col !== 'done') {
-                _element7.insertChild("870Ncen", _holder3);
+                _element7.insertChild(4, _holder3);
             } else {
-                _element7.removeChild("870Ncen");
+                _element7.removeChild(4);
             }
         }, [col]);
         _parent4.addChild(_element7);
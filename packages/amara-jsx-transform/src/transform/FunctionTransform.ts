@@ -26,7 +26,8 @@ export function processFunc(path: BabelFunction) {
         variables: new Set<string>(),
         specialFlags: {},
         innerFunctions: [],
-        foundChildren: false
+        foundChildren: false,
+        slots: 0
     }
 
     path.node.params.forEach(param => {
@@ -197,6 +198,8 @@ export function processFunc(path: BabelFunction) {
         }
 
     });
+    // Lets the runtime size the component's child slot tables once
+    componentBeginExpression.arguments.push(t.numericLiteral(funcState.slots + 1));
 }
 
 function containsJSX(path: NodePath) {
@@ -4,7 +4,8 @@ import {
 
     createObjectProperty, ensureReturnInMapCallback,
     extractMapInfo,
-    generateShortId, getJsxElementName,
+    getJsxElementName,
+    nextSlot,
     getPropertyKey,
     INTERNAL_COMPONENTS,
     isMapExpression, MapInfo
@@ -224,12 +225,12 @@ export function handleJsxExpression(
     const expression = path.node.expression;
     const statements: t.Statement[] = [];
     const deps: t.Identifier[] = [];
-    const expressionId = generateShortId();
 
     // Skip empty expressions like {}
     if (t.isJSXEmptyExpression(expression)) {
         return {statements, deps};
     }
+    const slot = nextSlot(funcState);
 
     // Handle logical expressions: condition && <Component/>, condition || <Component/>, condition ?? <Component/>
     if (t.isLogicalExpression(expression)) {
@@ -239,7 +240,7 @@ export function handleJsxExpression(
             funcState,
             parentElement,
             isParentText,
-            expressionId,
+            slot,
             statements,
             deps
         );
@@ -252,7 +253,7 @@ export function handleJsxExpression(
             funcState,
             parentElement,
             isParentText,
-            expressionId,
+            slot,
             statements,
             deps
         );
@@ -264,7 +265,7 @@ export function handleJsxExpression(
             funcState,
             parentElement,
             isParentText,
-            expressionId,
+            slot,
             statements,
             deps
         );
@@ -280,7 +281,7 @@ function handleLogicalExpression(
     funcState: FunctionScope,
     parentElement: t.Identifier,
     isParentText: boolean,
-    expressionId: string,
+    slot: number,
     statements: t.Statement[],
     deps: t.Identifier[]
 ): { statements: t.Statement[], deps: t.Identifier[] } {
@@ -300,7 +301,7 @@ function handleLogicalExpression(
             path,
             funcState,
             parentElement,
-            expressionId,
+            slot,
             stateDependency,
             statements,
             deps
@@ -312,7 +313,7 @@ function handleLogicalExpression(
             content,
             funcState,
             parentElement,
-            expressionId,
+            slot,
             isParentText,
             stateDependency,
             statements,
@@ -331,7 +332,7 @@ function handleLogicalJsxContent(
     path: NodePath<t.JSXExpressionContainer>,
     funcState: FunctionScope,
     parentElement: t.Identifier,
-    expressionId: string,
+    slot: number,
     stateDependency: string | null,
     statements: t.Statement[],
     deps: t.Identifier[]
@@ -346,7 +347,7 @@ function handleLogicalJsxContent(
 
     if (jsxResult.expression) {
         // Create placeholder in the parent element with a unique ID
-        const placeholderId = t.stringLiteral(expressionId);
+        const placeholderId = t.numericLiteral(slot);
 
         // Create the condition expression based on the operator
         let conditionExpr = condition;
@@ -412,7 +413,7 @@ function handleLogicalNonJsxContent(
     content: t.Expression,
     funcState: FunctionScope,
     parentElement: t.Identifier,
-    expressionId: string,
+    slot: number,
     isParentText: boolean,
     stateDependency: string | null,
     statements: t.Statement[],
@@ -496,7 +497,7 @@ function handleConditionalExpression(
     funcState: FunctionScope,
     parentElement: t.Identifier,
     isParentText: boolean,
-    expressionId: string,
+    slot: number,
     statements: t.Statement[],
     deps: t.Identifier[]
 ): { statements: t.Statement[], deps: t.Identifier[] } {
@@ -535,7 +536,7 @@ function handleConditionalExpression(
     }
 
     // Create placeholder in the parent element with a unique ID
-    const placeholderId = t.stringLiteral(expressionId);
+    const placeholderId = t.numericLiteral(slot);
 
     const effectBodyStatements = [];
 
@@ -640,8 +641,8 @@ function handleConditionalBranch(
 /**
  * Creates a text component object for non-JSX expressions
  */
-function createTextComponentObject(content: t.Expression): t.ObjectExpression {
-    return t.objectExpression([
+function createTextComponentObject(content: t.Expression, slot?: number): t.ObjectExpression {
+    const object = t.objectExpression([
         t.objectProperty(t.identifier('$$internalComponent'), t.booleanLiteral(true)),
         t.objectProperty(t.identifier('component'), t.stringLiteral('text')),
         t.objectProperty(
@@ -652,9 +653,12 @@ function createTextComponentObject(content: t.Expression): t.ObjectExpression {
                     t.arrayExpression([content])
                 )
             ])
-        ),
-        t.objectProperty(t.identifier('id'), t.stringLiteral(generateShortId()))
+        )
     ]);
+    if (slot !== undefined) {
+        object.properties.push(t.objectProperty(t.identifier('slot'), t.numericLiteral(slot)));
+    }
+    return object;
 }
 
 /**
@@ -665,7 +669,7 @@ function handleSimpleExpression(
     funcState: FunctionScope,
     parentElement: t.Identifier,
     isParentText: boolean,
-    expressionId: string,
+    slot: number,
     statements: t.Statement[],
     deps: t.Identifier[]
 ): { statements: t.Statement[], deps: t.Identifier[] } {
@@ -675,7 +679,7 @@ function handleSimpleExpression(
         deps.push(t.identifier(stateDependency));
 
         // Create placeholder with unique ID
-        const placeholderId = t.stringLiteral(expressionId);
+        const placeholderId = t.numericLiteral(slot);
 
         let expr: t.Expression;
         const isChildren = (funcState.foundChildren && t.isIdentifier(expression, {name: "children"}))
@@ -724,7 +728,7 @@ function handleSimpleExpression(
             t.expressionStatement(
                 t.callExpression(
                     t.memberExpression(parentElement, t.identifier('addStaticChild')),
-                    [createTextComponentObject(expression)]
+                    [createTextComponentObject(expression, slot)]
                 )
             )
         );
@@ -864,7 +868,6 @@ export function handleJsxElement(
             createObjectProperty("$$internalComponent", t.booleanLiteral(isInternal)),
             createObjectProperty("component", isInternal ? t.stringLiteral(elementName) : t.identifier(elementName)),
             createObjectProperty("props", staticProps),
-            createObjectProperty("id", t.stringLiteral(generateShortId())),
             createObjectProperty("key", key)
         ]);
         if (originalForceStatic && canCreateHolder && dynamicProps.length > 0) {
@@ -888,7 +891,7 @@ export function handleJsxElement(
         if (parentVariable) {
 
             const updater = t.callExpression(t.memberExpression(parentVariable, t.identifier("insertChild")), [
-                t.stringLiteral(generateShortId()),
+                t.numericLiteral(nextSlot(funcState)),
                 staticObject
             ]);
             const arrowFunction = t.arrowFunctionExpression([], t.blockStatement([t.expressionStatement(updater)]));
@@ -940,7 +943,12 @@ export function handleJsxElement(
     childrenResults.forEach(result => {
         statements.push(...result.statements)
         if (result.expression) {
-            const method = t.isObjectExpression(result.expression) ? "addStaticChild" : "addChild"
+            const isStatic = t.isObjectExpression(result.expression)
+            const method = isStatic ? "addStaticChild" : "addChild"
+            if (isStatic) {
+                (result.expression as t.ObjectExpression).properties.push(
+                    createObjectProperty("slot", t.numericLiteral(nextSlot(funcState))));
+            }
             const addCall = t.callExpression(
                 t.memberExpression(elementVariable, t.identifier(method)),
                 [result.expression]
@@ -14,6 +14,8 @@ export interface FunctionScope {
         scopedVariables: Set<string>;
     }>
     foundChildren: boolean
+    // Child slots handed out so far, see nextSlot
+    slots: number
 }
 
 export type LiteralType = string | number | boolean
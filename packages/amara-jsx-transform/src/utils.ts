@@ -8,6 +8,14 @@ export function generateShortId(length = 12) {
     return crypto.randomBytes(Math.ceil(length / 2)).toString('base64').replace(/[^a-zA-Z0-9]/g, '').slice(0, length);
 }
 
+/**
+ * Next dense child slot of the component, used by the runtime to index its children instead of hashing string IDs.
+ * Slot 0 is reserved for the `children` prop.
+ */
+export function nextSlot(funcState: FunctionScope) {
+    return ++funcState.slots;
+}
+
 export function getPropertyKey(prop: t.ObjectProperty): string | undefined {
     if (t.isIdentifier(prop.key)) {
         return prop.key.name;
@@ -292,7 +300,6 @@ function transformExpressionToObject(expr: t.Expression, valueParam: t.Identifie
             createObjectProperty("$$internalComponent", t.booleanLiteral(isInternal)),
             createObjectProperty("component", isInternal ? t.stringLiteral(elementName) : t.identifier(elementName)),
             createObjectProperty("props", t.objectExpression([])),  // Props would be processed fully in real implementation
-            createObjectProperty("id", t.stringLiteral(generateShortId())),
             createObjectProperty("key", keyAttr && keyAttr.value
                 ? t.isJSXExpressionContainer(keyAttr.value)
                     ? keyAttr.value.expression as t.Expression
@@ -326,7 +333,6 @@ function transformCallbackToObject(body: t.BlockStatement, valueParam: t.Identif
                 createObjectProperty("$$internalComponent", t.booleanLiteral(isInternal)),
                 createObjectProperty("component", isInternal ? t.stringLiteral(elementName) : t.identifier(elementName)),
                 createObjectProperty("props", t.objectExpression([])),  // Props would be processed fully in real implementation
-                createObjectProperty("id", t.stringLiteral(generateShortId())),
                 createObjectProperty("key", keyAttr && keyAttr.value
                     ? t.isJSXExpressionContainer(keyAttr.value)
                         ? keyAttr.value.expression as t.Expression
@@ -345,7 +351,6 @@ function transformCallbackToObject(body: t.BlockStatement, valueParam: t.Identif
         createObjectProperty("$$internalComponent", t.booleanLiteral(true)),
         createObjectProperty("component", t.stringLiteral("div")),
         createObjectProperty("props", t.objectExpression([])),
-        createObjectProperty("id", t.stringLiteral(generateShortId())),
         createObjectProperty("key", indexParam)
     ]);
 }